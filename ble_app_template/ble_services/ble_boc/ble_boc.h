@@ -1,181 +1,232 @@
-/* Copyright (c) 2012 Nordic Semiconductor. All Rights Reserved.
- *
- * The information contained herein is property of Nordic Semiconductor ASA.
- * Terms and conditions of usage are described in detail in NORDIC
- * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
- *
- * Licensees are granted free, non-transferable use of the information. NO
- * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
- * the file.
- *
- */
-
-/** @file
- *
- * @defgroup ble_sdk_srv_boc Binary Output Controller
- * @{
- * @ingroup ble_sdk_srv
- * @brief Battery Service module.
- *
- * @note The application must propagate BLE stack events to the Binary Output Controller module by calling
- *       ble_boc_on_ble_evt() from the @ref softdevice_handler callback.
- */
-
-#ifndef BLE_BOC_H__
-#define BLE_BOC_H__
-
-#include <stdint.h>
-#include <stdbool.h>
-#include "ble.h"
-#include "ble_srv_common.h"
-#include "ign_state_machine.h"
-#include "logger.h"
-
-/**@brief Battery Service event type. */
-typedef enum
-{
-    BLE_BOC_EVT_NOTIFICATION_ENABLED,                             /**< Battery value notification enabled event. */
-    BLE_BOC_EVT_NOTIFICATION_DISABLED                             /**< Battery value notification disabled event. */
-
-} ble_boc_evt_type_t;
-
-/**@brief Battery Service event. */
-typedef struct
-{
-    ble_boc_evt_type_t evt_type;                                  /**< Type of event. */
-} ble_boc_evt_t;
-
-// Forward declaration of the ble_boc_t type. 
-typedef struct ble_boc_s ble_boc_t;
-
-/**@brief Battery Service event handler type. */
-typedef void (*ble_boc_evt_handler_t) (ble_boc_t * p_boc, ble_boc_evt_t * p_evt);
-
-/**@brief Battery Service init structure. This contains all options and data needed for
- *        initialization of the service.*/
-typedef struct
-{
-    ble_boc_evt_handler_t         evt_handler;                    /**< Event handler to be called for handling events in the Battery Service. */
-    bool                          support_notification;           /**< TRUE if notification of Battery Level measurement is supported. */
-    ble_srv_report_ref_t *        p_report_ref;                   /**< If not NULL, a Report Reference descriptor with the specified value will be added to the Battery Level characteristic */
-    uint8_t                       initial_passcode[8];             /**< Initial battery level */\
-	uint8_t 					  initial_opcode;
-    uint8_t                       initial_operand[20];             /**< Initial battery level */\
-	uint8_t 					  initial_response[20];
-    ble_srv_cccd_security_mode_t  passcode_char_attr_md;     /**< Initial security level for battery characteristics attribute */
-    ble_gap_conn_sec_mode_t       passcode_report_read_perm; /**< Initial security level for battery report read attribute */
-	ble_srv_cccd_security_mode_t  opcode_char_attr_md;     /**< Initial security level for battery characteristics attribute */
-    ble_gap_conn_sec_mode_t       opcode_report_read_perm; /**< Initial security level for battery report read attribute */
-	ble_srv_cccd_security_mode_t  operand_char_attr_md;     /**< Initial security level for battery characteristics attribute */
-    ble_gap_conn_sec_mode_t       operand_report_read_perm; /**< Initial security level for battery report read attribute */
-	ble_srv_cccd_security_mode_t  response_char_attr_md;     /**< Initial security level for battery characteristics attribute */
-    ble_gap_conn_sec_mode_t       response_report_read_perm; /**< Initial security level for battery report read attribute */
-} ble_boc_init_t;
-
-/**@brief Battery Service structure. This contains various status information for the service. */
-struct ble_boc_s
-{
-    ble_boc_evt_handler_t         evt_handler;                    /**< Event handler to be called for handling events in the Battery Service. */
-    uint16_t                      service_handle;                 /**< Handle of Battery Service (as provided by the BLE stack). */
-    ble_gatts_char_handles_t      passcode_handles;          /**< Handles related to the Battery Level characteristic. */
-    ble_gatts_char_handles_t      opcode_handles;          /**< Handles related to the Battery Level characteristic. */
-    ble_gatts_char_handles_t      operand_handles;          /**< Handles related to the Battery Level characteristic. */
-    ble_gatts_char_handles_t      response_handles;          /**< Handles related to the Battery Level characteristic. */
-    uint16_t                      report_ref_handle;              /**< Handle of the Report Reference descriptor. */
-    uint16_t                      conn_handle;                    /**< Handle of the current connection (as provided by the BLE stack, is BLE_CONN_HANDLE_INVALID if not in a connection). */
-    bool                          is_notification_supported;      /**< TRUE if notification of Battery Level is supported. */
-};
-
-/**@brief Function for initializing the Battery Service.
- *
- * @param[out]  p_boc       Battery Service structure. This structure will have to be supplied by
- *                          the application. It will be initialized by this function, and will later
- *                          be used to identify this particular service instance.
- * @param[in]   p_boc_init  Information needed to initialize the service.
- *
- * @return      NRF_SUCCESS on successful initialization of service, otherwise an error code.
- */
-uint32_t ble_boc_init(ble_boc_t * p_boc, const ble_boc_init_t * p_boc_init);
-
-/**@brief Function for handling the Application's BLE Stack events.
- *
- * @details Handles all events from the BLE stack of interest to the Battery Service.
- *
- * @note For the requirements in the boc specification to be fulfilled,
- *       ble_boc_passcode_update() must be called upon reconnection if the
- *       battery level has changed while the service has been disconnected from a bonded
- *       client.
- *
- * @param[in]   p_boc      Battery Service structure.
- * @param[in]   p_ble_evt  Event received from the BLE stack.
- */
-void ble_boc_on_ble_evt(ble_boc_t * p_boc, ble_evt_t * p_ble_evt);
-
-/**@brief Function for updating the battery level.
- *
- * @details The application calls this function after having performed a battery measurement. If
- *          notification has been enabled, the battery level characteristic is sent to the client.
- *
- * @note For the requirements in the boc specification to be fulfilled,
- *       this function must be called upon reconnection if the battery level has changed
- *       while the service has been disconnected from a bonded client.
- *
- * @param[in]   p_boc          Battery Service structure.
- * @param[in]   passcode  New battery measurement value (in percent of full capacity).
- *
- * @return      NRF_SUCCESS on success, otherwise an error code.
- */
-uint32_t ble_boc_passcode_update(ble_boc_t * p_boc, uint8_t passcode);
-
-
-/**@brief Function for updating the battery level.
- *
- * @details The application calls this function after having performed a battery measurement. If
- *          notification has been enabled, the battery level characteristic is sent to the client.
- *
- * @note For the requirements in the boc specification to be fulfilled,
- *       this function must be called upon reconnection if the battery level has changed
- *       while the service has been disconnected from a bonded client.
- *
- * @param[in]   p_boc          Battery Service structure.
- * @param[in]   passcode  New battery measurement value (in percent of full capacity).
- *
- * @return      NRF_SUCCESS on success, otherwise an error code.
- */
-uint32_t ble_boc_opcode_update(ble_boc_t * p_boc, uint8_t opcode);
-
-/**@brief Function for updating the battery level.
- *
- * @details The application calls this function after having performed a battery measurement. If
- *          notification has been enabled, the battery level characteristic is sent to the client.
- *
- * @note For the requirements in the boc specification to be fulfilled,
- *       this function must be called upon reconnection if the battery level has changed
- *       while the service has been disconnected from a bonded client.
- *
- * @param[in]   p_boc          Battery Service structure.
- * @param[in]   passcode  New battery measurement value (in percent of full capacity).
- *
- * @return      NRF_SUCCESS on success, otherwise an error code.
- */
-uint32_t ble_boc_operand_update(ble_boc_t * p_boc, uint8_t opcode);
-
-/**@brief Function for updating the battery level.
- *
- * @details The application calls this function after having performed a battery measurement. If
- *          notification has been enabled, the battery level characteristic is sent to the client.
- *
- * @note For the requirements in the boc specification to be fulfilled,
- *       this function must be called upon reconnection if the battery level has changed
- *       while the service has been disconnected from a bonded client.
- *
- * @param[in]   p_boc          Battery Service structure.
- * @param[in]   passcode  New battery measurement value (in percent of full capacity).
- *
- * @return      NRF_SUCCESS on success, otherwise an error code.
- */
-uint32_t ble_boc_response_update(ble_boc_t * p_boc, void * response, uint8_t len);
-
-#endif // BLE_boc_H__
-
-/** @} */
+/* Copyright (c) 2012 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+/** @file
+ *
+ * @defgroup ble_sdk_srv_boc Binary Output Controller
+ * @{
+ * @ingroup ble_sdk_srv
+ * @brief Battery Service module.
+ *
+ * @note The application must propagate BLE stack events to the Binary Output Controller module by calling
+ *       ble_boc_on_ble_evt() from the @ref softdevice_handler callback.
+ */
+
+#ifndef BLE_BOC_H__
+#define BLE_BOC_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble.h"
+#include "ble_srv_common.h"
+#include "ign_state_machine.h"
+#include "diagnostics.h"
+#include "flight_recorder.h"
+#include "logger.h"
+
+/**@brief Battery Service event type. */
+typedef enum
+{
+    BLE_BOC_EVT_NOTIFICATION_ENABLED,                             /**< Battery value notification enabled event. */
+    BLE_BOC_EVT_NOTIFICATION_DISABLED                             /**< Battery value notification disabled event. */
+
+} ble_boc_evt_type_t;
+
+/**@brief Battery Service event. */
+typedef struct
+{
+    ble_boc_evt_type_t evt_type;                                  /**< Type of event. */
+} ble_boc_evt_t;
+
+#define BLE_BOC_MAX_VALUE_LEN     20                              /**< Maximum length of a characteristic value, one notification with the default ATT MTU. */
+#define BLE_BOC_TX_QUEUE_SIZE     8                               /**< Number of characteristic updates that can be pending, must be a power of two. */
+
+#define BLE_BOC_UPDATE_FLUSH      0x01                            /**< Send the update, and everything queued before it, right away. */
+#define BLE_BOC_UPDATE_COALESCE   0x02                            /**< Append to a pending update of the same characteristic that has not been flushed yet. */
+
+/**@brief Pending characteristic update. */
+typedef struct
+{
+    uint16_t                      value_handle;                   /**< Handle of the characteristic value to update. */
+    uint8_t                       len;                            /**< Length of the new value. */
+    uint8_t                       data[BLE_BOC_MAX_VALUE_LEN];    /**< New value. */
+} ble_boc_tx_t;
+
+// Forward declaration of the ble_boc_t type. 
+typedef struct ble_boc_s ble_boc_t;
+
+/**@brief Battery Service event handler type. */
+typedef void (*ble_boc_evt_handler_t) (ble_boc_t * p_boc, ble_boc_evt_t * p_evt);
+
+/**@brief Battery Service init structure. This contains all options and data needed for
+ *        initialization of the service.*/
+typedef struct
+{
+    ble_boc_evt_handler_t         evt_handler;                    /**< Event handler to be called for handling events in the Battery Service. */
+    bool                          support_notification;           /**< TRUE if notification of Battery Level measurement is supported. */
+    ble_srv_report_ref_t *        p_report_ref;                   /**< If not NULL, a Report Reference descriptor with the specified value will be added to the Battery Level characteristic */
+    uint8_t                       initial_passcode[8];             /**< Initial battery level */\
+	uint8_t 					  initial_opcode;
+    uint8_t                       initial_operand[20];             /**< Initial battery level */\
+	uint8_t 					  initial_response[20];
+    ble_srv_cccd_security_mode_t  passcode_char_attr_md;     /**< Initial security level for battery characteristics attribute */
+    ble_gap_conn_sec_mode_t       passcode_report_read_perm; /**< Initial security level for battery report read attribute */
+	ble_srv_cccd_security_mode_t  opcode_char_attr_md;     /**< Initial security level for battery characteristics attribute */
+    ble_gap_conn_sec_mode_t       opcode_report_read_perm; /**< Initial security level for battery report read attribute */
+	ble_srv_cccd_security_mode_t  operand_char_attr_md;     /**< Initial security level for battery characteristics attribute */
+    ble_gap_conn_sec_mode_t       operand_report_read_perm; /**< Initial security level for battery report read attribute */
+	ble_srv_cccd_security_mode_t  response_char_attr_md;     /**< Initial security level for battery characteristics attribute */
+    ble_gap_conn_sec_mode_t       response_report_read_perm; /**< Initial security level for battery report read attribute */
+    ble_srv_cccd_security_mode_t  command_char_attr_md;      /**< Initial security level for the command characteristic attribute */
+    ble_srv_cccd_security_mode_t  diag_char_attr_md;         /**< Initial security level for the diagnostics characteristic attribute */
+    ble_srv_cccd_security_mode_t  fr_char_attr_md;           /**< Initial security level for the flight recorder characteristic attribute */
+} ble_boc_init_t;
+
+/**@brief Battery Service structure. This contains various status information for the service. */
+struct ble_boc_s
+{
+    ble_boc_evt_handler_t         evt_handler;                    /**< Event handler to be called for handling events in the Battery Service. */
+    uint16_t                      service_handle;                 /**< Handle of Battery Service (as provided by the BLE stack). */
+    ble_gatts_char_handles_t      passcode_handles;          /**< Handles related to the Battery Level characteristic. */
+    ble_gatts_char_handles_t      opcode_handles;          /**< Handles related to the Battery Level characteristic. */
+    ble_gatts_char_handles_t      operand_handles;          /**< Handles related to the Battery Level characteristic. */
+    ble_gatts_char_handles_t      response_handles;          /**< Handles related to the Battery Level characteristic. */
+    ble_gatts_char_handles_t      command_handles;           /**< Handles related to the Command characteristic. */
+    ble_gatts_char_handles_t      diag_handles;              /**< Handles related to the Diagnostics characteristic. */
+    ble_gatts_char_handles_t      fr_handles;                /**< Handles related to the Flight Recorder characteristic. */
+    uint16_t                      report_ref_handle;              /**< Handle of the Report Reference descriptor. */
+    uint16_t                      conn_handle;                    /**< Handle of the current connection (as provided by the BLE stack, is BLE_CONN_HANDLE_INVALID if not in a connection). */
+    bool                          is_notification_supported;      /**< TRUE if notification of Battery Level is supported. */
+    ble_boc_tx_t                  tx_queue[BLE_BOC_TX_QUEUE_SIZE];/**< Characteristic updates waiting to be sent. */
+    uint8_t                       tx_head;                        /**< Free running index of the next update to send. */
+    uint8_t                       tx_tail;                        /**< Free running index of the next free slot. */
+    uint8_t                       tx_batch;                       /**< Free running index of the first update queued since the last flush. */
+    uint32_t                      tx_dropped;                     /**< Number of updates dropped because the queue was full. */
+};
+
+/**@brief Function for initializing the Battery Service.
+ *
+ * @param[out]  p_boc       Battery Service structure. This structure will have to be supplied by
+ *                          the application. It will be initialized by this function, and will later
+ *                          be used to identify this particular service instance.
+ * @param[in]   p_boc_init  Information needed to initialize the service.
+ *
+ * @return      NRF_SUCCESS on successful initialization of service, otherwise an error code.
+ */
+uint32_t ble_boc_init(ble_boc_t * p_boc, const ble_boc_init_t * p_boc_init);
+
+/**@brief Function for handling the Application's BLE Stack events.
+ *
+ * @details Handles all events from the BLE stack of interest to the Battery Service.
+ *
+ * @note For the requirements in the boc specification to be fulfilled,
+ *       ble_boc_passcode_update() must be called upon reconnection if the
+ *       battery level has changed while the service has been disconnected from a bonded
+ *       client.
+ *
+ * @param[in]   p_boc      Battery Service structure.
+ * @param[in]   p_ble_evt  Event received from the BLE stack.
+ */
+void ble_boc_on_ble_evt(ble_boc_t * p_boc, ble_evt_t * p_ble_evt);
+
+/**@brief Function for queueing an update of one of the service's characteristics.
+ *
+ * @details The value is set in the attribute table and, if connected and notification is
+ *          supported, notified to the client. Updates are sent in the order they were queued.
+ *          If the stack is out of TX buffers the remaining updates are kept and retried when
+ *          BLE_EVT_TX_COMPLETE arrives.
+ *
+ * @param[in]   p_boc          Binary Output Controller structure.
+ * @param[in]   value_handle   Handle of the characteristic value.
+ * @param[in]   p_data         New value (or the bytes to append when coalescing).
+ * @param[in]   len            Length of p_data, at most BLE_BOC_MAX_VALUE_LEN.
+ * @param[in]   flags          BLE_BOC_UPDATE_FLUSH and/or BLE_BOC_UPDATE_COALESCE.
+ *
+ * @return      NRF_SUCCESS on success, NRF_ERROR_NO_MEM if the queue is full, otherwise an error code.
+ */
+uint32_t ble_boc_char_update(ble_boc_t * p_boc, uint16_t value_handle, const void * p_data, uint8_t len, uint8_t flags);
+
+/**@brief Function for sending every queued characteristic update.
+ *
+ * @details Closes the current batch, so later coalescing updates start a new notification.
+ *
+ * @param[in]   p_boc          Binary Output Controller structure.
+ *
+ * @return      NRF_SUCCESS on success, otherwise the error code of the last update sent.
+ */
+uint32_t ble_boc_tx_flush(ble_boc_t * p_boc);
+
+/**@brief Function for updating the battery level.
+ *
+ * @details The application calls this function after having performed a battery measurement. If
+ *          notification has been enabled, the battery level characteristic is sent to the client.
+ *
+ * @note For the requirements in the boc specification to be fulfilled,
+ *       this function must be called upon reconnection if the battery level has changed
+ *       while the service has been disconnected from a bonded client.
+ *
+ * @param[in]   p_boc          Battery Service structure.
+ * @param[in]   passcode  New battery measurement value (in percent of full capacity).
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+uint32_t ble_boc_passcode_update(ble_boc_t * p_boc, uint8_t passcode);
+
+
+/**@brief Function for updating the battery level.
+ *
+ * @details The application calls this function after having performed a battery measurement. If
+ *          notification has been enabled, the battery level characteristic is sent to the client.
+ *
+ * @note For the requirements in the boc specification to be fulfilled,
+ *       this function must be called upon reconnection if the battery level has changed
+ *       while the service has been disconnected from a bonded client.
+ *
+ * @param[in]   p_boc          Battery Service structure.
+ * @param[in]   passcode  New battery measurement value (in percent of full capacity).
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+uint32_t ble_boc_opcode_update(ble_boc_t * p_boc, uint8_t opcode);
+
+/**@brief Function for updating the battery level.
+ *
+ * @details The application calls this function after having performed a battery measurement. If
+ *          notification has been enabled, the battery level characteristic is sent to the client.
+ *
+ * @note For the requirements in the boc specification to be fulfilled,
+ *       this function must be called upon reconnection if the battery level has changed
+ *       while the service has been disconnected from a bonded client.
+ *
+ * @param[in]   p_boc          Battery Service structure.
+ * @param[in]   passcode  New battery measurement value (in percent of full capacity).
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+uint32_t ble_boc_operand_update(ble_boc_t * p_boc, uint8_t opcode);
+
+/**@brief Function for queueing a response.
+ *
+ * @details Responses are coalesced until ble_boc_tx_flush() is called, so all responses produced
+ *          while handling one event reach the client in a single notification.
+ *
+ * @param[in]   p_boc          Binary Output Controller structure.
+ * @param[in]   response       Response bytes.
+ * @param[in]   len            Number of response bytes.
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+uint32_t ble_boc_response_update(ble_boc_t * p_boc, void * response, uint8_t len);
+
+#endif // BLE_boc_H__
+
+/** @} */
@@ -0,0 +1,171 @@
+#include "host_app.h"
+#include <string.h>
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "ble_hci.h"
+#include "ble_srv_common.h"
+#include "app_timer.h"
+#include "app_error.h"
+#include "pstorage.h"
+#include "ign_state_machine.h"
+#include "diagnostics.h"
+#include "power_profile.h"
+#include "conn_policy.h"
+#include "kv_store.h"
+#include "flight_recorder.h"
+#include "timebase.h"
+#include "uart_cmd.h"
+#include "nrf_gpio.h"
+#include "nrf_soc.h"
+
+#define APP_TIMER_PRESCALER              0
+#define APP_TIMER_MAX_TIMERS             8          // main.c's 7 and the BSP's one
+#define APP_TIMER_OP_QUEUE_SIZE          4
+
+// APP_TIMER_BUF_SIZE() is worked out for 32 bit pointers
+static uint64_t m_app_timer_buf[512];
+
+static ble_boc_t m_boc;
+static uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID;
+
+static void timers_init(void){
+    uint32_t err_code = app_timer_init(APP_TIMER_PRESCALER, APP_TIMER_MAX_TIMERS, APP_TIMER_OP_QUEUE_SIZE + 1,
+                                       (uint32_t*)m_app_timer_buf, NULL);
+    APP_ERROR_CHECK(err_code);
+    timebase_init();
+}
+
+static void services_init(void){
+    uint32_t       err_code;
+    ble_boc_init_t boc_init;
+
+    memset(&boc_init, 0, sizeof(boc_init));
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.passcode_char_attr_md.cccd_write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.passcode_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.passcode_char_attr_md.write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.passcode_report_read_perm);
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.opcode_char_attr_md.cccd_write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.opcode_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.opcode_char_attr_md.write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.opcode_report_read_perm);
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.operand_char_attr_md.cccd_write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.operand_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.operand_char_attr_md.write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.operand_report_read_perm);
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.response_char_attr_md.cccd_write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.response_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.response_char_attr_md.write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.response_report_read_perm);
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.command_char_attr_md.cccd_write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.command_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.command_char_attr_md.write_perm);
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.diag_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&boc_init.fr_char_attr_md.read_perm);
+
+    boc_init.evt_handler          = NULL;
+    boc_init.support_notification = true;
+    boc_init.p_report_ref         = NULL;
+
+    err_code = ble_boc_init(&m_boc, &boc_init);
+    APP_ERROR_CHECK(err_code);
+}
+
+// The state machine's part of main.c's on_ble_evt()
+static void on_ble_evt(ble_evt_t * p_ble_evt){
+    uint32_t err_code;
+
+    switch (p_ble_evt->header.evt_id){
+        case BLE_GAP_EVT_CONNECTED:
+            if(uart_cmd_session_open()){
+                err_code = sd_ble_gap_disconnect(p_ble_evt->evt.gap_evt.conn_handle,
+                                                 BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+                APP_ERROR_CHECK(err_code);
+                break;
+            }
+            m_conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+            add_event(EVT_CONNECTED, NULL, 0);
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            if(p_ble_evt->evt.gap_evt.conn_handle != m_conn_handle){
+                break;
+            }
+            m_conn_handle = BLE_CONN_HANDLE_INVALID;
+            add_event(EVT_DISCONNECTED, NULL, 0);
+            diag_dump();
+            break;
+
+        case BLE_EVT_USER_MEM_REQUEST:
+            err_code = sd_ble_user_mem_reply(m_conn_handle, NULL);
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void ble_evt_dispatch(ble_evt_t * p_ble_evt){
+    power_profile_wake_reason(POWER_WAKE_BLE);
+    ble_boc_on_ble_evt(&m_boc, p_ble_evt);
+    on_ble_evt(p_ble_evt);
+}
+
+void host_app_init(void){
+    uint32_t err_code;
+
+    flight_recorder_init();
+    timers_init();
+
+    nrf_gpio_cfg_input(20, NRF_GPIO_PIN_PULLDOWN);
+    nrf_gpio_cfg_output(4);
+    nrf_gpio_cfg_output(5);
+    nrf_gpio_cfg_output(8);
+    nrf_gpio_cfg_output(10);
+    nrf_gpio_pin_clear(4);
+    nrf_gpio_pin_clear(5);
+    nrf_gpio_pin_clear(8);
+    nrf_gpio_pin_clear(10);
+
+    sdk_host_ble_handler_set(ble_evt_dispatch);
+    err_code = pstorage_init();
+    APP_ERROR_CHECK(err_code);
+    kv_store_init();
+    services_init();
+    conn_policy_init();
+
+    state_machine_init(&m_boc);
+    uart_cmd_init();
+}
+
+void host_app_run_until(uint64_t tick){
+    sdk_host_wait_deadline_set(tick);
+    while(sdk_host_now() < tick){
+        while(events_queued()){
+            process_event();
+        }
+        passcodes_refill();
+
+        power_profile_sleep();
+        uint32_t err_code = sd_app_evt_wait();
+        APP_ERROR_CHECK(err_code);
+        power_profile_wake();
+    }
+    while(events_queued()){
+        process_event();
+    }
+}
+
+ble_boc_t * host_app_boc(void){
+    return &m_boc;
+}
+
+uint16_t host_app_conn_handle(void){
+    return m_conn_handle;
+}
@@ -0,0 +1,21 @@
+/*
+ *  Host Application
+ *
+ *  The parts of main.c the host build can run: the same initialisation
+ *  order, the state machine's share of on_ble_evt() and the main loop,
+ *  bounded by a virtual deadline instead of running forever. Advertising,
+ *  bonding, buttons and the BSP have no stand-ins and are left out.
+ */
+
+#ifndef HOST_APP_H__
+#define HOST_APP_H__
+
+#include <stdint.h>
+#include "ble_boc.h"
+
+void host_app_init(void);
+void host_app_run_until(uint64_t tick);        // Main loop until sdk_host_now() reaches tick
+ble_boc_t * host_app_boc(void);
+uint16_t host_app_conn_handle(void);
+
+#endif
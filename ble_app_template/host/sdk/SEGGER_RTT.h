@@ -0,0 +1,23 @@
+/*
+ *  Host stand-in for SEGGER_RTT.h. Up buffer 0 goes to stdout when
+ *  sdk_host_log_enable() was called, and nowhere otherwise.
+ */
+
+#ifndef SEGGER_RTT_H
+#define SEGGER_RTT_H
+
+#define RTT_CTRL_RESET                ""
+#define RTT_CTRL_CLEAR                ""
+#define RTT_CTRL_TEXT_WHITE           ""
+#define RTT_CTRL_TEXT_BRIGHT_GREEN    ""
+#define RTT_CTRL_TEXT_BRIGHT_YELLOW   ""
+#define RTT_CTRL_TEXT_BRIGHT_RED      ""
+#define RTT_CTRL_BG_BLACK             ""
+#define RTT_CTRL_BG_RED               ""
+
+unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void* pBuffer, unsigned NumBytes);
+// Checked like printf(), RTT pulls every argument as 32 bits and a 64 bit
+// one shifts the rest of the record
+int SEGGER_RTT_printf(unsigned BufferIndex, const char * sFormat, ...) __attribute__((format(printf, 2, 3)));
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ *  Host stand-in for the SDK's app_util.h.
+ */
+
+#ifndef APP_UTIL_H__
+#define APP_UTIL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "compiler_abstraction.h"
+
+// app_timer.c checks its node and queue sizes against the APP_TIMER_*_SIZE
+// constants of a 32-bit target. The host hands app_timer_init() a buffer of
+// its own, so those checks are left out where SDK_HOST_NO_SIZE_ASSERTS is set.
+#ifdef SDK_HOST_NO_SIZE_ASSERTS
+#define STATIC_ASSERT(EXPR)
+#else
+#define STATIC_ASSERT(EXPR) _Static_assert((EXPR), #EXPR)
+#endif
+
+enum
+{
+    UNIT_0_625_MS = 625,
+    UNIT_1_25_MS  = 1250,
+    UNIT_10_MS    = 10000
+};
+
+#define MSEC_TO_UNITS(TIME, RESOLUTION) (((TIME) * 1000) / (RESOLUTION))
+#define ROUNDED_DIV(A, B) (((A) + ((B) / 2)) / (B))
+#define CEIL_DIV(A, B) (((A) + (B) - 1) / (B))
+#define IS_POWER_OF_TWO(A) (((A) != 0) && ((((A) - 1) & (A)) == 0))
+
+static __INLINE bool is_word_aligned(void const * p)
+{
+    return (((uintptr_t)p & 0x03) == 0);
+}
+
+#endif
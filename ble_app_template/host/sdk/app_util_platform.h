@@ -0,0 +1,35 @@
+/*
+ *  Host stand-in for the SDK's app_util_platform.h. Critical regions mask the
+ *  emulated interrupts of sdk_host.c, like PRIMASK does on the target.
+ */
+
+#ifndef APP_UTIL_PLATFORM_H__
+#define APP_UTIL_PLATFORM_H__
+
+#include <stdint.h>
+#include "compiler_abstraction.h"
+#include "nrf.h"
+
+typedef enum
+{
+    APP_IRQ_PRIORITY_HIGH = 1,
+    APP_IRQ_PRIORITY_LOW  = 3
+} app_irq_priority_t;
+
+#define NRF_APP_PRIORITY_THREAD 4
+
+void app_util_critical_region_enter(uint8_t * p_nested);
+void app_util_critical_region_exit(uint8_t nested);
+
+#define CRITICAL_REGION_ENTER()                         \
+    {                                                   \
+        uint8_t __CR_NESTED = 0;                        \
+        app_util_critical_region_enter(&__CR_NESTED);
+
+#define CRITICAL_REGION_EXIT()                          \
+        app_util_critical_region_exit(__CR_NESTED);     \
+    }
+
+uint8_t current_int_priority_get(void);
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ *  Host stand-in for the S110 8.0 ble.h.
+ */
+
+#ifndef BLE_H__
+#define BLE_H__
+
+#include <stdint.h>
+#include "ble_types.h"
+#include "ble_err.h"
+#include "ble_gap.h"
+#include "ble_gatts.h"
+
+#define BLE_EVT_BASE 0x01
+
+enum BLE_COMMON_EVTS
+{
+    BLE_EVT_TX_COMPLETE = BLE_EVT_BASE,
+    BLE_EVT_USER_MEM_REQUEST,
+    BLE_EVT_USER_MEM_RELEASE
+};
+
+typedef struct
+{
+    uint8_t  count;
+} ble_evt_tx_complete_t;
+
+typedef struct
+{
+    uint8_t  type;
+} ble_evt_user_mem_request_t;
+
+typedef struct
+{
+    uint16_t conn_handle;
+    union
+    {
+        ble_evt_tx_complete_t      tx_complete;
+        ble_evt_user_mem_request_t user_mem_request;
+    } params;
+} ble_common_evt_t;
+
+typedef struct
+{
+    uint16_t evt_id;
+    uint16_t evt_len;
+} ble_evt_hdr_t;
+
+typedef struct
+{
+    ble_evt_hdr_t header;
+    union
+    {
+        ble_common_evt_t common_evt;
+        ble_gap_evt_t    gap_evt;
+        ble_gatts_evt_t  gatts_evt;
+    } evt;
+} ble_evt_t;
+
+typedef struct
+{
+    uint8_t  *p_mem;
+    uint16_t  len;
+} ble_user_mem_block_t;
+
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const *p_vs_uuid, uint8_t *p_uuid_type);
+uint32_t sd_ble_user_mem_reply(uint16_t conn_handle, ble_user_mem_block_t const *p_block);
+
+#endif
@@ -0,0 +1,14 @@
+/*
+ *  Host stand-in for the SDK's ble_conn_params.h. A parameter change is
+ *  recorded by sdk_host.c and granted as asked.
+ */
+
+#ifndef BLE_CONN_PARAMS_H__
+#define BLE_CONN_PARAMS_H__
+
+#include <stdint.h>
+#include "ble.h"
+
+uint32_t ble_conn_params_change_conn_params(ble_gap_conn_params_t * new_params);
+
+#endif
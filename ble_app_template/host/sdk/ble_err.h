@@ -0,0 +1,17 @@
+/*
+ *  Host stand-in for the S110 8.0 ble_err.h.
+ */
+
+#ifndef BLE_ERR_H__
+#define BLE_ERR_H__
+
+#include "nrf_error.h"
+
+#define BLE_ERROR_NOT_ENABLED            (NRF_ERROR_STK_BASE_NUM+0x001)
+#define BLE_ERROR_INVALID_CONN_HANDLE    (NRF_ERROR_STK_BASE_NUM+0x002)
+#define BLE_ERROR_INVALID_ATTR_HANDLE    (NRF_ERROR_STK_BASE_NUM+0x003)
+#define BLE_ERROR_NO_TX_BUFFERS          (NRF_ERROR_STK_BASE_NUM+0x004)
+
+#define BLE_ERROR_GATTS_SYS_ATTR_MISSING (NRF_ERROR_STK_BASE_NUM+0x401)
+
+#endif
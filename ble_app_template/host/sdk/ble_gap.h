@@ -0,0 +1,60 @@
+/*
+ *  Host stand-in for the S110 8.0 ble_gap.h, the parts the firmware uses.
+ */
+
+#ifndef BLE_GAP_H__
+#define BLE_GAP_H__
+
+#include <stdint.h>
+#include "ble_types.h"
+#include "ble_err.h"
+
+#define BLE_GAP_EVT_BASE 0x10
+
+enum BLE_GAP_EVTS
+{
+    BLE_GAP_EVT_CONNECTED = BLE_GAP_EVT_BASE,
+    BLE_GAP_EVT_DISCONNECTED,
+    BLE_GAP_EVT_CONN_PARAM_UPDATE
+};
+
+#define BLE_GAP_CONN_SEC_MODE_SET_NO_ACCESS(ptr) do {(ptr)->sm = 0; (ptr)->lv = 0;} while(0)
+#define BLE_GAP_CONN_SEC_MODE_SET_OPEN(ptr)      do {(ptr)->sm = 1; (ptr)->lv = 1;} while(0)
+
+typedef struct
+{
+    uint8_t sm : 4;
+    uint8_t lv : 4;
+} ble_gap_conn_sec_mode_t;
+
+typedef struct
+{
+    uint16_t min_conn_interval;
+    uint16_t max_conn_interval;
+    uint16_t slave_latency;
+    uint16_t conn_sup_timeout;
+} ble_gap_conn_params_t;
+
+typedef struct
+{
+    ble_gap_conn_params_t conn_params;
+} ble_gap_evt_connected_t;
+
+typedef struct
+{
+    uint8_t reason;
+} ble_gap_evt_disconnected_t;
+
+typedef struct
+{
+    uint16_t conn_handle;
+    union
+    {
+        ble_gap_evt_connected_t    connected;
+        ble_gap_evt_disconnected_t disconnected;
+    } params;
+} ble_gap_evt_t;
+
+uint32_t sd_ble_gap_disconnect(uint16_t conn_handle, uint8_t hci_status_code);
+
+#endif
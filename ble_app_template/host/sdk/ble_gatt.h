@@ -0,0 +1,36 @@
+/*
+ *  Host stand-in for the S110 8.0 ble_gatt.h.
+ */
+
+#ifndef BLE_GATT_H__
+#define BLE_GATT_H__
+
+#include <stdint.h>
+
+#define BLE_GATT_HANDLE_INVALID     0x0000
+
+#define BLE_GATT_HVX_INVALID        0x00
+#define BLE_GATT_HVX_NOTIFICATION   0x01
+#define BLE_GATT_HVX_INDICATION     0x02
+
+#define BLE_GATT_STATUS_SUCCESS                 0x0000
+#define BLE_GATT_STATUS_ATTERR_READ_NOT_PERMITTED 0x0102
+
+typedef struct
+{
+    uint8_t broadcast       :1;
+    uint8_t read            :1;
+    uint8_t write_wo_resp   :1;
+    uint8_t write           :1;
+    uint8_t notify          :1;
+    uint8_t indicate        :1;
+    uint8_t auth_signed_wr  :1;
+} ble_gatt_char_props_t;
+
+typedef struct
+{
+    uint8_t reliable_wr     :1;
+    uint8_t wr_aux          :1;
+} ble_gatt_char_ext_props_t;
+
+#endif
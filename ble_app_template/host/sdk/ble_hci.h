@@ -0,0 +1,13 @@
+/*
+ *  Host stand-in for the S110 8.0 ble_hci.h.
+ */
+
+#ifndef BLE_HCI_H__
+#define BLE_HCI_H__
+
+#define BLE_HCI_STATUS_CODE_SUCCESS                     0x00
+#define BLE_HCI_CONNECTION_TIMEOUT                      0x08
+#define BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION       0x13
+#define BLE_HCI_LOCAL_HOST_TERMINATED_CONNECTION        0x16
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ *  Host stand-in for the SDK's ble_srv_common.h.
+ */
+
+#ifndef BLE_SRV_COMMON_H__
+#define BLE_SRV_COMMON_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble.h"
+
+#define BLE_SRV_ENCODED_REPORT_REF_LEN 2
+
+typedef struct
+{
+    ble_gap_conn_sec_mode_t read_perm;
+    ble_gap_conn_sec_mode_t write_perm;
+} ble_srv_security_mode_t;
+
+typedef struct
+{
+    ble_gap_conn_sec_mode_t cccd_write_perm;
+    ble_gap_conn_sec_mode_t read_perm;
+    ble_gap_conn_sec_mode_t write_perm;
+} ble_srv_cccd_security_mode_t;
+
+typedef struct
+{
+    uint8_t report_id;
+    uint8_t report_type;
+} ble_srv_report_ref_t;
+
+static inline bool ble_srv_is_notification_enabled(uint8_t * p_encoded_data)
+{
+    return (p_encoded_data[0] & 0x01) != 0;
+}
+
+uint8_t ble_srv_report_ref_encode(uint8_t * p_encoded_buffer, const ble_srv_report_ref_t * p_report_ref);
+
+#endif
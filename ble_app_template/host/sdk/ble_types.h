@@ -0,0 +1,34 @@
+/*
+ *  Host stand-in for the S110 8.0 ble_types.h.
+ */
+
+#ifndef BLE_TYPES_H__
+#define BLE_TYPES_H__
+
+#include <stdint.h>
+
+#define BLE_CONN_HANDLE_INVALID 0xFFFF
+
+#define BLE_UUID_TYPE_UNKNOWN       0x00
+#define BLE_UUID_TYPE_BLE           0x01
+#define BLE_UUID_TYPE_VENDOR_BEGIN  0x02
+
+#define BLE_UUID_BATTERY_SERVICE    0x180F
+#define BLE_UUID_REPORT_REF_DESCR   0x2908
+
+#define BLE_UUID_BLE_ASSIGN(instance, value) do {\
+            instance.type = BLE_UUID_TYPE_BLE; \
+            instance.uuid = value;} while(0)
+
+typedef struct
+{
+    uint8_t uuid128[16];
+} ble_uuid128_t;
+
+typedef struct
+{
+    uint16_t    uuid;
+    uint8_t     type;
+} ble_uuid_t;
+
+#endif
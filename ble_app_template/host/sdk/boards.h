@@ -0,0 +1,11 @@
+/*
+ *  Host stand-in for the SDK's boards.h, with BOARD_CUSTOM.
+ */
+
+#ifndef BOARDS_H
+#define BOARDS_H
+
+#include "nrf_gpio.h"
+#include "custom_board.h"
+
+#endif
@@ -0,0 +1,14 @@
+/*
+ *  Host stand-in for the SDK's compiler_abstraction.h.
+ */
+
+#ifndef COMPILER_ABSTRACTION_H__
+#define COMPILER_ABSTRACTION_H__
+
+#define __ASM           __asm__
+#define __INLINE        inline
+#define __STATIC_INLINE static inline
+#define __WEAK          __attribute__((weak))
+#define __ALIGN(n)      __attribute__((aligned(n)))
+
+#endif
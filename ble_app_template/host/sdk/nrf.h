@@ -0,0 +1,11 @@
+/*
+ *  Host stand-in for the SDK's nrf.h.
+ */
+
+#ifndef NRF_H__
+#define NRF_H__
+
+#include "nrf51.h"
+#include "nrf51_bitfields.h"
+
+#endif
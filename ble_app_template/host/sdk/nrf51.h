@@ -0,0 +1,105 @@
+/*
+ *  Host stand-in for the SDK's nrf51.h. Only the peripherals the firmware
+ *  touches exist, as plain memory that sdk_host.c brings to life: RTC1 counts
+ *  in virtual time and raises its compare interrupt, the task and SET/CLR
+ *  registers take effect the next time the emulation gets control (a critical
+ *  region, an NVIC call, a delay or a SoftDevice call), like a write buffer.
+ *  UART0 shifts a byte per character time at its baud rate, what it sends
+ *  and receives goes through sdk_host_uart_tx() and sdk_host_uart_rx().
+ */
+
+#ifndef NRF51_H__
+#define NRF51_H__
+
+#include <stdint.h>
+
+typedef enum {
+    POWER_CLOCK_IRQn = 0,
+    RADIO_IRQn       = 1,
+    UART0_IRQn       = 2,
+    GPIOTE_IRQn      = 6,
+    RTC0_IRQn        = 11,
+    RTC1_IRQn        = 17,
+    SWI0_IRQn        = 20,
+    SWI1_IRQn        = 21,
+    SWI2_IRQn        = 22,
+    SWI3_IRQn        = 23,
+    SWI4_IRQn        = 24,
+    SWI5_IRQn        = 25
+} IRQn_Type;
+
+typedef struct {
+    volatile uint32_t TASKS_START;
+    volatile uint32_t TASKS_STOP;
+    volatile uint32_t TASKS_CLEAR;
+    volatile uint32_t TASKS_TRIGOVRFLW;
+    volatile uint32_t EVENTS_TICK;
+    volatile uint32_t EVENTS_OVRFLW;
+    volatile uint32_t EVENTS_COMPARE[4];
+    volatile uint32_t INTENSET;
+    volatile uint32_t INTENCLR;
+    volatile uint32_t EVTEN;
+    volatile uint32_t EVTENSET;
+    volatile uint32_t EVTENCLR;
+    volatile uint32_t COUNTER;
+    volatile uint32_t PRESCALER;
+    volatile uint32_t CC[4];
+} NRF_RTC_Type;
+
+typedef struct {
+    volatile uint32_t OUT;
+    volatile uint32_t OUTSET;
+    volatile uint32_t OUTCLR;
+    volatile uint32_t IN;
+    volatile uint32_t DIR;
+    volatile uint32_t DIRSET;
+    volatile uint32_t DIRCLR;
+    volatile uint32_t PIN_CNF[32];
+} NRF_GPIO_Type;
+
+typedef struct {
+    volatile uint32_t RESETREAS;
+} NRF_POWER_Type;
+
+// INTENSET reads back the enabled interrupts, ERRORSRC is never set since
+// the line has no errors
+typedef struct {
+    volatile uint32_t TASKS_STARTRX;
+    volatile uint32_t TASKS_STOPRX;
+    volatile uint32_t TASKS_STARTTX;
+    volatile uint32_t TASKS_STOPTX;
+    volatile uint32_t EVENTS_RXDRDY;
+    volatile uint32_t EVENTS_TXDRDY;
+    volatile uint32_t EVENTS_ERROR;
+    volatile uint32_t INTENSET;
+    volatile uint32_t INTENCLR;
+    volatile uint32_t ERRORSRC;
+    volatile uint32_t ENABLE;
+    volatile uint32_t PSELRTS;
+    volatile uint32_t PSELTXD;
+    volatile uint32_t PSELCTS;
+    volatile uint32_t PSELRXD;
+    volatile uint32_t RXD;
+    volatile uint32_t TXD;
+    volatile uint32_t BAUDRATE;
+    volatile uint32_t CONFIG;
+} NRF_UART_Type;
+
+extern NRF_RTC_Type   sdk_host_rtc1;
+extern NRF_GPIO_Type  sdk_host_gpio;
+extern NRF_POWER_Type sdk_host_power;
+extern NRF_UART_Type  sdk_host_uart0;
+
+#define NRF_RTC1  (&sdk_host_rtc1)
+#define NRF_GPIO  (&sdk_host_gpio)
+#define NRF_POWER (&sdk_host_power)
+#define NRF_UART0 (&sdk_host_uart0)
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+void NVIC_SystemReset(void);
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ *  Host stand-in for the SDK's nrf51_bitfields.h, the RTC bits app_timer uses
+ *  and the UART ones app_uart uses.
+ */
+
+#ifndef NRF51_BITFIELDS_H__
+#define NRF51_BITFIELDS_H__
+
+#define RTC_EVTEN_COMPARE0_Msk    (0x1UL << 16)
+#define RTC_INTENSET_COMPARE0_Msk (0x1UL << 16)
+
+#define UART_INTENSET_RXDRDY_Pos  2
+#define UART_INTENSET_RXDRDY_Msk  (0x1UL << UART_INTENSET_RXDRDY_Pos)
+#define UART_INTENSET_RXDRDY_Set  1
+#define UART_INTENSET_TXDRDY_Pos  7
+#define UART_INTENSET_TXDRDY_Msk  (0x1UL << UART_INTENSET_TXDRDY_Pos)
+#define UART_INTENSET_TXDRDY_Set  1
+#define UART_INTENSET_ERROR_Pos   9
+#define UART_INTENSET_ERROR_Msk   (0x1UL << UART_INTENSET_ERROR_Pos)
+#define UART_INTENSET_ERROR_Set   1
+
+#define UART_ENABLE_ENABLE_Pos      0
+#define UART_ENABLE_ENABLE_Disabled 0x00
+#define UART_ENABLE_ENABLE_Enabled  0x04
+
+#define UART_BAUDRATE_BAUDRATE_Pos        0
+#define UART_BAUDRATE_BAUDRATE_Baud9600   0x00275000UL
+#define UART_BAUDRATE_BAUDRATE_Baud19200  0x004EA000UL
+#define UART_BAUDRATE_BAUDRATE_Baud38400  0x009D5000UL
+#define UART_BAUDRATE_BAUDRATE_Baud57600  0x00EBF000UL
+#define UART_BAUDRATE_BAUDRATE_Baud115200 0x01D7E000UL
+#define UART_BAUDRATE_BAUDRATE_Baud230400 0x03AFB000UL
+#define UART_BAUDRATE_BAUDRATE_Baud460800 0x075F7000UL
+#define UART_BAUDRATE_BAUDRATE_Baud921600 0x0EBEDFA4UL
+#define UART_BAUDRATE_BAUDRATE_Baud1M     0x10000000UL
+
+#define UART_CONFIG_HWFC_Pos          0
+#define UART_CONFIG_HWFC_Enabled      1
+#define UART_CONFIG_PARITY_Pos        1
+#define UART_CONFIG_PARITY_Excluded   0
+#define UART_CONFIG_PARITY_Included   7
+
+#endif
@@ -0,0 +1,13 @@
+/*
+ *  Host stand-in for the SDK's nrf_delay.h. Waiting lets the emulated
+ *  peripherals act on the tasks written before it.
+ */
+
+#ifndef NRF_DELAY_H__
+#define NRF_DELAY_H__
+
+#include <stdint.h>
+
+void nrf_delay_us(uint32_t volatile number_of_us);
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ *  Host stand-in for the SDK's nrf_drv_gpiote.h. GPIOTE isn't emulated, so
+ *  the driver never initialises and app_uart's low power flow control, the
+ *  only user, gets NRF_ERROR_NOT_SUPPORTED from app_uart_init().
+ */
+
+#ifndef NRF_DRV_GPIOTE_H__
+#define NRF_DRV_GPIOTE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_error.h"
+
+typedef uint32_t nrf_drv_gpiote_pin_t;
+
+typedef enum
+{
+    NRF_GPIOTE_POLARITY_LOTOHI = 1,
+    NRF_GPIOTE_POLARITY_HITOLO = 2,
+    NRF_GPIOTE_POLARITY_TOGGLE = 3
+} nrf_gpiote_polarity_t;
+
+typedef struct
+{
+    bool init_state;
+} nrf_drv_gpiote_out_config_t;
+
+typedef struct
+{
+    nrf_gpiote_polarity_t sense;
+    bool hi_accuracy;
+} nrf_drv_gpiote_in_config_t;
+
+typedef void (*nrf_drv_gpiote_evt_handler_t)(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action);
+
+#define GPIOTE_CONFIG_OUT_SIMPLE(init_high) { .init_state = (init_high) }
+#define GPIOTE_CONFIG_IN_SENSE_TOGGLE(hi_accu) { .sense = NRF_GPIOTE_POLARITY_TOGGLE, .hi_accuracy = (hi_accu) }
+
+static inline bool nrf_drv_gpiote_is_init(void){
+    return false;
+}
+
+static inline uint32_t nrf_drv_gpiote_init(void){
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+static inline uint32_t nrf_drv_gpiote_out_init(nrf_drv_gpiote_pin_t pin, nrf_drv_gpiote_out_config_t const * p_config){
+    (void)pin;
+    (void)p_config;
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+static inline uint32_t nrf_drv_gpiote_in_init(nrf_drv_gpiote_pin_t pin, nrf_drv_gpiote_in_config_t const * p_config,
+                                              nrf_drv_gpiote_evt_handler_t evt_handler){
+    (void)pin;
+    (void)p_config;
+    (void)evt_handler;
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+static inline void nrf_drv_gpiote_in_event_enable(nrf_drv_gpiote_pin_t pin, bool int_enable){
+    (void)pin;
+    (void)int_enable;
+}
+
+static inline bool nrf_drv_gpiote_in_is_set(nrf_drv_gpiote_pin_t pin){
+    (void)pin;
+    return false;
+}
+
+static inline void nrf_drv_gpiote_in_uninit(nrf_drv_gpiote_pin_t pin){
+    (void)pin;
+}
+
+#endif
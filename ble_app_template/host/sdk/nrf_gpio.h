@@ -0,0 +1,41 @@
+/*
+ *  Host stand-in for the SDK's nrf_gpio.h. The pins are set and cleared in
+ *  OUT straight away, so a test reads the outputs without waiting for the
+ *  emulation to fold OUTSET and OUTCLR.
+ */
+
+#ifndef NRF_GPIO_H__
+#define NRF_GPIO_H__
+
+#include <stdint.h>
+#include "nrf.h"
+
+typedef enum
+{
+    NRF_GPIO_PIN_NOPULL   = 0,
+    NRF_GPIO_PIN_PULLDOWN = 1,
+    NRF_GPIO_PIN_PULLUP   = 3
+} nrf_gpio_pin_pull_t;
+
+static inline void nrf_gpio_pin_set(uint32_t pin_number)
+{
+    NRF_GPIO->OUT |= (1UL << pin_number);
+}
+
+static inline void nrf_gpio_pin_clear(uint32_t pin_number)
+{
+    NRF_GPIO->OUT &= ~(1UL << pin_number);
+}
+
+static inline void nrf_gpio_cfg_output(uint32_t pin_number)
+{
+    NRF_GPIO->DIR |= (1UL << pin_number);
+}
+
+static inline void nrf_gpio_cfg_input(uint32_t pin_number, nrf_gpio_pin_pull_t pull_config)
+{
+    NRF_GPIO->DIR &= ~(1UL << pin_number);
+    NRF_GPIO->PIN_CNF[pin_number] = (uint32_t)pull_config << 2;
+}
+
+#endif
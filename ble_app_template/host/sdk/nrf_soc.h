@@ -0,0 +1,14 @@
+/*
+ *  Host stand-in for the SDK's nrf_soc.h.
+ */
+
+#ifndef NRF_SOC_H__
+#define NRF_SOC_H__
+
+#include <stdint.h>
+#include "nrf_error.h"
+
+// Sleeps until the next emulated interrupt, see sdk_host.h
+uint32_t sd_app_evt_wait(void);
+
+#endif
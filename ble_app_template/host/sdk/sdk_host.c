@@ -0,0 +1,596 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <signal.h>
+#include "sdk_host.h"
+#include "nrf.h"
+#include "nrf_soc.h"
+#include "nrf_delay.h"
+#include "nrf_error.h"
+#include "app_util_platform.h"
+#include "SEGGER_RTT.h"
+
+#define RTC_COUNTER_MASK 0xFFFFFF
+#define AGENDA_SIZE 64
+#define EVT_QUEUE_SIZE 64                       // Must be a power of two
+#define EVT_DATA_WORDS 32
+#define NO_EVENT UINT64_MAX
+#define UART_LINE_SIZE 4096                     // Bytes either way not yet taken, a power of two
+#define UART_TXD_EMPTY 0xFFFFFFFF               // TXD holds a byte only between a write and the next update
+#define UART_BITS_PER_BYTE 10                   // Start, 8 data and stop
+
+typedef struct {
+        uint64_t tick;
+        uint32_t order;                         // Same tick runs in the order scheduled
+        sdk_host_fn_t fn;
+        void * p_context;
+        bool used;
+} agenda_item_t;
+
+typedef struct {
+        sdk_host_fn_t fn;
+        void * p_context;
+        uint16_t len;
+        uint32_t data[EVT_DATA_WORDS];
+} evt_item_t;
+
+NRF_RTC_Type   sdk_host_rtc1;
+NRF_GPIO_Type  sdk_host_gpio;
+NRF_POWER_Type sdk_host_power;
+NRF_UART_Type  sdk_host_uart0 = { .TXD = UART_TXD_EMPTY };
+uint8_t sdk_host_noinit_ram[SDK_HOST_NOINIT_SIZE] __attribute__((aligned(4)));
+
+// app_timer.c brings these, a test that doesn't link it has no RTC1 or SWI0
+extern void RTC1_IRQHandler(void) __attribute__((weak));
+extern void SWI0_IRQHandler(void) __attribute__((weak));
+// And app_uart.c this one
+extern void UART0_IRQHandler(void) __attribute__((weak));
+static void SWI2_IRQHandler(void);
+
+static void (*m_handlers[32])(void) = { [SWI2_IRQn] = SWI2_IRQHandler };
+static uint32_t m_enabled = 1UL << SWI2_IRQn;   // The SoftDevice enables its own
+static uint32_t m_pending = 0;
+static volatile sig_atomic_t m_primask = 0;     // Critical region nesting
+static int m_active = 0;                        // Held while a handler runs, or while one is picked
+static int m_updating = 0;
+static volatile sig_atomic_t m_event = 0;       // The WFE event register
+
+static uint64_t m_now = 0;
+static uint64_t m_wait_deadline = NO_EVENT;
+static bool m_rtc_running = false;
+static uint64_t m_rtc_zero = 0;                 // Tick at which the counter was last 0
+static uint32_t m_rtc_inten = 0;
+
+static agenda_item_t m_agenda[AGENDA_SIZE];
+static uint32_t m_agenda_order = 0;
+
+static evt_item_t m_evt_queue[EVT_QUEUE_SIZE];
+static uint32_t m_evt_head = 0;
+static uint32_t m_evt_tail = 0;
+
+static uint32_t m_uart_inten = 0;
+static bool m_uart_tx_started = false;
+static bool m_uart_rx_started = false;
+static bool m_uart_tx_busy = false;             // A byte is on the line
+static bool m_uart_rx_busy = false;             // The next received byte is scheduled
+static uint8_t m_uart_tx_line[UART_LINE_SIZE];  // Sent, for sdk_host_uart_tx()
+static uint32_t m_uart_tx_head = 0;
+static uint32_t m_uart_tx_tail = 0;
+static uint8_t m_uart_rx_line[UART_LINE_SIZE];  // Given to sdk_host_uart_rx(), still to come in
+static uint32_t m_uart_rx_head = 0;
+static uint32_t m_uart_rx_tail = 0;
+
+static int m_log = -1;                          // Unknown until the first record
+
+static void agenda_add(uint64_t tick, sdk_host_fn_t fn, void * p_context);
+
+static void fatal(const char * p_reason){
+    fprintf(stderr, "sdk_host: %s\n", p_reason);
+    abort();
+}
+
+static void rtc_counter_update(void){
+    if(m_rtc_running){
+        NRF_RTC1->COUNTER = (uint32_t)(m_now - m_rtc_zero) & RTC_COUNTER_MASK;
+    }
+}
+
+static uint64_t uart_byte_ticks(void){
+    uint64_t baud = ((uint64_t)NRF_UART0->BAUDRATE * 16000000) >> 32;
+
+    if(baud == 0){
+        return 1;
+    }
+    return (UART_BITS_PER_BYTE * SDK_HOST_TICKS_PER_SECOND + baud - 1) / baud;
+}
+
+static void uart_event(volatile uint32_t * p_event, uint32_t mask){
+    *p_event = 1;
+    if(m_uart_inten & mask){
+        __atomic_fetch_or(&m_pending, 1UL << UART0_IRQn, __ATOMIC_SEQ_CST);
+    }
+}
+
+// The byte written to TXD is out, runs from SWI2
+static void uart_tx_done(void * p_context){
+    if(m_uart_tx_tail - m_uart_tx_head >= UART_LINE_SIZE){
+        fatal("UART output not taken with sdk_host_uart_tx()");
+    }
+    m_uart_tx_line[m_uart_tx_tail++ & (UART_LINE_SIZE - 1)] = (uint8_t)(uintptr_t)p_context;
+    m_uart_tx_busy = false;
+    uart_event(&NRF_UART0->EVENTS_TXDRDY, UART_INTENSET_TXDRDY_Msk);
+}
+
+// The next byte from the line is in, runs from SWI2. Like the receiver
+// without its FIFO, a byte RXD still holds is overwritten.
+static void uart_rx_done(void * p_context){
+    uint8_t byte;
+
+    (void)p_context;
+    CRITICAL_REGION_ENTER();
+    byte = m_uart_rx_line[m_uart_rx_head++ & (UART_LINE_SIZE - 1)];
+    m_uart_rx_busy = (m_uart_rx_head != m_uart_rx_tail);
+    if(m_uart_rx_busy){
+        sdk_host_at(m_now + uart_byte_ticks(), uart_rx_done, NULL);
+    }
+    if(NRF_UART0->ENABLE == UART_ENABLE_ENABLE_Enabled && m_uart_rx_started){
+        NRF_UART0->RXD = byte;
+        uart_event(&NRF_UART0->EVENTS_RXDRDY, UART_INTENSET_RXDRDY_Msk);
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+static void uart_update(void){
+    NRF_UART_Type * p_uart = NRF_UART0;
+
+    if(p_uart->TASKS_STARTTX){
+        p_uart->TASKS_STARTTX = 0;
+        m_uart_tx_started = true;
+    }
+    if(p_uart->TASKS_STOPTX){
+        p_uart->TASKS_STOPTX = 0;
+        m_uart_tx_started = false;
+    }
+    if(p_uart->TASKS_STARTRX){
+        p_uart->TASKS_STARTRX = 0;
+        m_uart_rx_started = true;
+    }
+    if(p_uart->TASKS_STOPRX){
+        p_uart->TASKS_STOPRX = 0;
+        m_uart_rx_started = false;
+    }
+
+    // Set bits not yet enabled are new, whatever else INTENSET holds is the read back
+    m_uart_inten = (m_uart_inten & ~p_uart->INTENCLR) | (p_uart->INTENSET & ~m_uart_inten);
+    p_uart->INTENSET = m_uart_inten;
+    p_uart->INTENCLR = 0;
+
+    if(p_uart->TXD != UART_TXD_EMPTY){
+        uint8_t byte = (uint8_t)p_uart->TXD;
+
+        p_uart->TXD = UART_TXD_EMPTY;
+        if(p_uart->ENABLE == UART_ENABLE_ENABLE_Enabled && m_uart_tx_started){
+            if(m_uart_tx_busy){
+                fatal("UART TXD written before TXDRDY");
+            }
+            // Masked without a critical region, whose exit would run handlers mid update
+            m_uart_tx_busy = true;
+            m_primask++;
+            agenda_add(m_now + uart_byte_ticks(), uart_tx_done, (void *)(uintptr_t)byte);
+            m_primask--;
+        }
+    }
+}
+
+// Makes the register writes since the last call take effect
+static void peripherals_update(void){
+    NRF_RTC_Type * p_rtc = NRF_RTC1;
+
+    if(__atomic_exchange_n(&m_updating, 1, __ATOMIC_SEQ_CST)){
+        return;
+    }
+
+    rtc_counter_update();
+    if(p_rtc->TASKS_STOP){
+        p_rtc->TASKS_STOP = 0;
+        m_rtc_running = false;
+    }
+    if(p_rtc->TASKS_CLEAR){
+        p_rtc->TASKS_CLEAR = 0;
+        p_rtc->COUNTER = 0;
+        m_rtc_zero = m_now;
+    }
+    if(p_rtc->TASKS_START){
+        p_rtc->TASKS_START = 0;
+        if(!m_rtc_running){
+            m_rtc_zero = m_now - p_rtc->COUNTER;
+            m_rtc_running = true;
+        }
+    }
+
+    m_rtc_inten = (m_rtc_inten | p_rtc->INTENSET) & ~p_rtc->INTENCLR;
+    p_rtc->INTENSET = 0;
+    p_rtc->INTENCLR = 0;
+    p_rtc->EVTEN = (p_rtc->EVTEN | p_rtc->EVTENSET) & ~p_rtc->EVTENCLR;
+    p_rtc->EVTENSET = 0;
+    p_rtc->EVTENCLR = 0;
+
+    NRF_GPIO->OUT = (NRF_GPIO->OUT | NRF_GPIO->OUTSET) & ~NRF_GPIO->OUTCLR;
+    NRF_GPIO->OUTSET = 0;
+    NRF_GPIO->OUTCLR = 0;
+    NRF_GPIO->DIR = (NRF_GPIO->DIR | NRF_GPIO->DIRSET) & ~NRF_GPIO->DIRCLR;
+    NRF_GPIO->DIRSET = 0;
+    NRF_GPIO->DIRCLR = 0;
+
+    uart_update();
+
+    __atomic_store_n(&m_updating, 0, __ATOMIC_SEQ_CST);
+}
+
+static void (*handler_get(uint32_t irq))(void){
+    if(m_handlers[irq]){
+        return m_handlers[irq];
+    }
+    if(irq == RTC1_IRQn){
+        return RTC1_IRQHandler;
+    }
+    if(irq == SWI0_IRQn){
+        return SWI0_IRQHandler;
+    }
+    if(irq == UART0_IRQn){
+        return UART0_IRQHandler;
+    }
+    return NULL;
+}
+
+// Runs the pending handlers, lowest IRQ number first, unless interrupts are
+// masked or a handler is already running. m_active is taken before looking,
+// so a signal arriving meanwhile only pends and is picked up by the loop.
+static void dispatch(void){
+    for(;;){
+        uint32_t ready;
+
+        if(__atomic_exchange_n(&m_active, 1, __ATOMIC_SEQ_CST)){
+            return;
+        }
+
+        ready = m_primask ? 0 : (__atomic_load_n(&m_pending, __ATOMIC_SEQ_CST) & m_enabled);
+        if(ready){
+            uint32_t bit = ready & -ready;
+            uint32_t irq = __builtin_ctz(bit);
+
+            if(__atomic_fetch_and(&m_pending, ~bit, __ATOMIC_SEQ_CST) & bit){
+                void (*handler)(void) = handler_get(irq);
+
+                if(handler){
+                    handler();
+                }
+                peripherals_update();
+                m_event = 1;
+            }
+        }
+
+        __atomic_store_n(&m_active, 0, __ATOMIC_SEQ_CST);
+
+        if(!ready && (m_primask || !(__atomic_load_n(&m_pending, __ATOMIC_SEQ_CST) & m_enabled))){
+            return;
+        }
+    }
+}
+
+static uint64_t rtc_next_compare(void){
+    uint32_t counter;
+    uint32_t distance;
+
+    if(!m_rtc_running || !(m_rtc_inten & RTC_INTENSET_COMPARE0_Msk)){
+        return NO_EVENT;
+    }
+
+    // The counter must move onto CC, one it is already on matches a wrap later
+    counter = (uint32_t)(m_now - m_rtc_zero) & RTC_COUNTER_MASK;
+    distance = (NRF_RTC1->CC[0] - counter) & RTC_COUNTER_MASK;
+    if(distance == 0){
+        distance = RTC_COUNTER_MASK + 1;
+    }
+    return m_now + distance;
+}
+
+static agenda_item_t * agenda_next(void){
+    agenda_item_t * p_next = NULL;
+
+    for(int i = 0; i < AGENDA_SIZE; i++){
+        agenda_item_t * p_item = &m_agenda[i];
+
+        if(p_item->used && (p_next == NULL || p_item->tick < p_next->tick
+                            || (p_item->tick == p_next->tick && (int32_t)(p_item->order - p_next->order) < 0))){
+            p_next = p_item;
+        }
+    }
+    return p_next;
+}
+
+// Moves time to the next RTC compare or agenda item and fires it, or to limit
+// if nothing comes before. Returns false in the latter case.
+static bool step(uint64_t limit){
+    agenda_item_t * p_item;
+    sdk_host_fn_t fn = NULL;
+    void * p_context = NULL;
+    uint64_t rtc;
+    uint64_t agenda;
+    uint64_t next;
+
+    peripherals_update();
+    dispatch();
+
+    CRITICAL_REGION_ENTER();
+    p_item = agenda_next();
+    rtc = rtc_next_compare();
+    agenda = p_item ? p_item->tick : NO_EVENT;
+    next = (rtc < agenda) ? rtc : agenda;
+
+    if(next == NO_EVENT && limit == NO_EVENT){
+        fatal("waiting for an event that never comes");
+    }
+
+    if(next > limit){
+        if(limit > m_now){
+            m_now = limit;
+        }
+        rtc_counter_update();
+        next = NO_EVENT;
+    } else {
+        if(next > m_now){
+            m_now = next;
+        }
+        rtc_counter_update();
+
+        if(next == rtc && (p_item == NULL || rtc <= p_item->tick)){
+            NRF_RTC1->EVENTS_COMPARE[0] = 1;
+            __atomic_fetch_or(&m_pending, 1UL << RTC1_IRQn, __ATOMIC_SEQ_CST);
+        } else {
+            fn = p_item->fn;
+            p_context = p_item->p_context;
+            p_item->used = false;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    if(fn){
+        sdk_host_evt_post(fn, p_context, NULL, 0);
+    }
+    return next != NO_EVENT;
+}
+
+static void SWI2_IRQHandler(void){
+    evt_item_t item;
+
+    for(;;){
+        bool empty;
+
+        CRITICAL_REGION_ENTER();
+        empty = (m_evt_head == m_evt_tail);
+        if(!empty){
+            item = m_evt_queue[m_evt_head & (EVT_QUEUE_SIZE - 1)];
+            m_evt_head++;
+        }
+        CRITICAL_REGION_EXIT();
+
+        if(empty){
+            return;
+        }
+        item.fn(item.len ? (void *)item.data : item.p_context);
+    }
+}
+
+void sdk_host_evt_post(sdk_host_fn_t fn, void * p_context, const void * p_data, uint16_t len){
+    evt_item_t * p_item;
+
+    if(len > sizeof(p_item->data)){
+        fatal("SoftDevice event too long");
+    }
+
+    CRITICAL_REGION_ENTER();
+    if(m_evt_tail - m_evt_head >= EVT_QUEUE_SIZE){
+        fatal("SoftDevice event queue overflow");
+    }
+    p_item = &m_evt_queue[m_evt_tail & (EVT_QUEUE_SIZE - 1)];
+    p_item->fn = fn;
+    p_item->p_context = p_context;
+    p_item->len = p_data ? len : 0;
+    if(p_item->len){
+        memcpy(p_item->data, p_data, len);
+    }
+    m_evt_tail++;
+    CRITICAL_REGION_EXIT();
+
+    NVIC_SetPendingIRQ(SWI2_IRQn);
+}
+
+uint64_t sdk_host_now(void){
+    return m_now;
+}
+
+void sdk_host_run_until(uint64_t tick){
+    while(step(tick)){
+    }
+}
+
+void sdk_host_wait_deadline_set(uint64_t tick){
+    m_wait_deadline = tick;
+}
+
+// The caller masks interrupts
+static void agenda_add(uint64_t tick, sdk_host_fn_t fn, void * p_context){
+    int i;
+
+    for(i = 0; i < AGENDA_SIZE && m_agenda[i].used; i++){
+    }
+    if(i == AGENDA_SIZE){
+        fatal("agenda full");
+    }
+    m_agenda[i].tick = (tick < m_now) ? m_now : tick;
+    m_agenda[i].order = m_agenda_order++;
+    m_agenda[i].fn = fn;
+    m_agenda[i].p_context = p_context;
+    m_agenda[i].used = true;
+}
+
+void sdk_host_at(uint64_t tick, sdk_host_fn_t fn, void * p_context){
+    CRITICAL_REGION_ENTER();
+    agenda_add(tick, fn, p_context);
+    CRITICAL_REGION_EXIT();
+}
+
+void sdk_host_irq_handler_set(IRQn_Type irqn, void (*handler)(void)){
+    m_handlers[irqn] = handler;
+}
+
+void sdk_host_irq_raise(IRQn_Type irqn){
+    __atomic_fetch_or(&m_pending, 1UL << irqn, __ATOMIC_SEQ_CST);
+    dispatch();
+}
+
+bool sdk_host_in_isr(void){
+    return __atomic_load_n(&m_active, __ATOMIC_SEQ_CST);
+}
+
+void sdk_host_uart_rx(const void * p_data, uint32_t len){
+    CRITICAL_REGION_ENTER();
+    if(m_uart_rx_tail - m_uart_rx_head + len > UART_LINE_SIZE){
+        fatal("UART input too long");
+    }
+    for(uint32_t i = 0; i < len; i++){
+        m_uart_rx_line[m_uart_rx_tail++ & (UART_LINE_SIZE - 1)] = ((const uint8_t *)p_data)[i];
+    }
+    if(!m_uart_rx_busy && len){
+        m_uart_rx_busy = true;
+        sdk_host_at(m_now + uart_byte_ticks(), uart_rx_done, NULL);
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+uint32_t sdk_host_uart_tx(uint8_t * p_buf, uint32_t size){
+    uint32_t len = 0;
+
+    CRITICAL_REGION_ENTER();
+    while(len < size && m_uart_tx_head != m_uart_tx_tail){
+        p_buf[len++] = m_uart_tx_line[m_uart_tx_head++ & (UART_LINE_SIZE - 1)];
+    }
+    CRITICAL_REGION_EXIT();
+    return len;
+}
+
+uint32_t sdk_host_gpio_out(void){
+    peripherals_update();
+    return NRF_GPIO->OUT;
+}
+
+void sdk_host_log_enable(bool enable){
+    m_log = enable;
+}
+
+/*
+ *  SDK and SoftDevice functions
+ */
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority){
+    (void)IRQn;
+    (void)priority;
+}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn){
+    __atomic_fetch_or(&m_enabled, 1UL << IRQn, __ATOMIC_SEQ_CST);
+    peripherals_update();
+    dispatch();
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn){
+    __atomic_fetch_and(&m_enabled, ~(1UL << IRQn), __ATOMIC_SEQ_CST);
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type IRQn){
+    __atomic_fetch_or(&m_pending, 1UL << IRQn, __ATOMIC_SEQ_CST);
+    peripherals_update();
+    dispatch();
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn){
+    __atomic_fetch_and(&m_pending, ~(1UL << IRQn), __ATOMIC_SEQ_CST);
+}
+
+void NVIC_SystemReset(void){
+    fatal("NVIC_SystemReset()");
+}
+
+void app_util_critical_region_enter(uint8_t * p_nested){
+    *p_nested = (m_primask != 0);
+    m_primask++;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+void app_util_critical_region_exit(uint8_t nested){
+    (void)nested;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    if(--m_primask == 0){
+        peripherals_update();
+        dispatch();
+    }
+}
+
+uint8_t current_int_priority_get(void){
+    return __atomic_load_n(&m_active, __ATOMIC_SEQ_CST) ? APP_IRQ_PRIORITY_LOW : NRF_APP_PRIORITY_THREAD;
+}
+
+void nrf_delay_us(uint32_t volatile number_of_us){
+    (void)number_of_us;
+    peripherals_update();
+}
+
+// WFE: returns at once if an interrupt ran since the last call, otherwise
+// sleeps until one does or the wait deadline passes
+uint32_t sd_app_evt_wait(void){
+    peripherals_update();
+    dispatch();
+
+    while(!m_event && step(m_wait_deadline)){
+    }
+    m_event = 0;
+    return NRF_SUCCESS;
+}
+
+static bool log_enabled(void){
+    if(m_log < 0){
+        m_log = getenv("SDK_HOST_LOG") != NULL;
+    }
+    return m_log;
+}
+
+int SEGGER_RTT_printf(unsigned BufferIndex, const char * sFormat, ...){
+    va_list args;
+    int len;
+
+    (void)BufferIndex;
+    if(!log_enabled()){
+        return 0;
+    }
+
+    va_start(args, sFormat);
+    len = vprintf(sFormat, args);
+    va_end(args);
+    return len;
+}
+
+unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void* pBuffer, unsigned NumBytes){
+    (void)BufferIndex;
+    if(log_enabled()){
+        fwrite(pBuffer, 1, NumBytes, stdout);
+    }
+    return NumBytes;
+}
+
+// A test expecting an error brings its own
+__attribute__((weak)) void app_error_handler(uint32_t error_code, uint32_t line_num, const uint8_t * p_file_name){
+    fprintf(stderr, "sdk_host: app_error_handler(0x%X) at %s:%u\n", (unsigned)error_code,
+            p_file_name ? (const char *)p_file_name : "?", (unsigned)line_num);
+    abort();
+}
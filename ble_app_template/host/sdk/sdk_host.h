@@ -0,0 +1,61 @@
+/*
+ *  Host SDK Emulation
+ *
+ *  Lets the firmware sources run unchanged on a PC. Every firmware file is
+ *  compiled with this header forced in front of it (-include sdk_host.h),
+ *  the headers next to it stand in for the nRF51 SDK and S110 ones.
+ *
+ *  Interrupts are emulated: a pended IRQ runs its handler as soon as no
+ *  critical region is held and no other handler is running, handlers never
+ *  nest (everything is APP_IRQ_PRIORITY_LOW, as on the target) and pends
+ *  made meanwhile tail-chain. Time is virtual RTC ticks at 32768 Hz and only
+ *  moves in sd_app_evt_wait() or sdk_host_run_until(), jumping straight to
+ *  the next RTC1 compare or scheduled host event, so a day of operation
+ *  runs in milliseconds and every run is repeatable.
+ *
+ *  SoftDevice events (BLE, pstorage completions, sdk_host_at() callbacks)
+ *  are delivered from SWI2, the SoftDevice event interrupt.
+ */
+
+#ifndef SDK_HOST_H__
+#define SDK_HOST_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "nrf51.h"
+
+#define SDK_HOST_TICKS_PER_SECOND 32768
+#define SDK_HOST_MS(ms) (((uint64_t)(ms) * SDK_HOST_TICKS_PER_SECOND) / 1000)
+#define SDK_HOST_NOINIT_SIZE 0x200
+
+typedef void (*sdk_host_fn_t)(void * p_context);
+
+// Stands in for the RAM the target's startup code leaves alone, see flight_recorder.h
+extern uint8_t sdk_host_noinit_ram[SDK_HOST_NOINIT_SIZE];
+
+// Virtual time
+uint64_t sdk_host_now(void);
+void sdk_host_run_until(uint64_t tick);
+void sdk_host_wait_deadline_set(uint64_t tick);
+void sdk_host_at(uint64_t tick, sdk_host_fn_t fn, void * p_context);
+
+// Runs fn from SWI2, given a copy of p_data if there is one and p_context otherwise
+void sdk_host_evt_post(sdk_host_fn_t fn, void * p_context, const void * p_data, uint16_t len);
+
+// Interrupts. sdk_host_irq_raise() is safe to call from a POSIX signal
+// handler, which preempts the main loop like a real interrupt would.
+void sdk_host_irq_handler_set(IRQn_Type irqn, void (*handler)(void));
+void sdk_host_irq_raise(IRQn_Type irqn);
+bool sdk_host_in_isr(void);
+
+uint32_t sdk_host_gpio_out(void);
+
+// The far end of the UART0 line. Bytes given to sdk_host_uart_rx() come in
+// one per character time from now, sdk_host_uart_tx() takes up to size of
+// the bytes sent since the last call and returns how many it took.
+void sdk_host_uart_rx(const void * p_data, uint32_t len);
+uint32_t sdk_host_uart_tx(uint8_t * p_buf, uint32_t size);
+void sdk_host_log_enable(bool enable);
+
+#endif
@@ -0,0 +1,652 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "ble.h"
+#include "ble_hci.h"
+#include "ble_srv_common.h"
+#include "ble_conn_params.h"
+#include "pstorage.h"
+#include "app_util_platform.h"
+
+#define ATTR_MAX 64
+#define ATTR_VALUE_MAX 64                       // Larger values must live in application memory
+#define UUID_CCCD 0x2902
+#define EVT_BUF_WORDS 16
+
+#define PSTORAGE_QUEUE_SIZE 10                  // PSTORAGE_CMD_QUEUE_SIZE of the SDK
+#define PSTORAGE_MODULES 4
+#define FLASH_SIZE (SDK_HOST_FLASH_PAGES * PSTORAGE_FLASH_PAGE_SIZE)
+
+typedef struct {
+        uint16_t uuid;
+        uint8_t * p_user;                       // Value in application memory, BLE_GATTS_VLOC_USER
+        uint8_t value[ATTR_VALUE_MAX];
+        uint16_t len;
+        uint16_t max_len;
+        bool vlen;
+        bool rd_auth;
+} attr_t;
+
+typedef struct {
+        uint8_t op_code;
+        pstorage_handle_t handle;
+        uint8_t * p_src;
+        pstorage_size_t size;
+        pstorage_size_t offset;
+        bool fail;                              // Completes with an error, flash untouched
+} flash_op_t;
+
+typedef struct {
+        pstorage_ntf_cb_t cb;
+        uint32_t base;
+        pstorage_size_t block_size;
+        pstorage_size_t block_count;
+} flash_module_t;
+
+static sdk_host_ble_evt_handler_t m_ble_handler = NULL;
+static sdk_host_hvx_handler_t m_hvx_handler = NULL;
+
+static attr_t m_attrs[ATTR_MAX];                // Handle n is m_attrs[n - 1]
+static uint16_t m_attr_count = 0;
+static uint8_t m_vs_uuid_count = 0;
+
+static bool m_connected = false;
+static bool m_disconnecting = false;
+static uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID;
+static uint16_t m_next_conn_handle = 0;
+static uint32_t m_link = 0;                     // Incremented per disconnect, stale link events are dropped
+static uint64_t m_interval_ticks = 1;
+static uint8_t m_tx_in_flight = 0;
+static bool m_tx_complete_scheduled = false;
+static bool m_auth_pending = false;
+static ble_gap_conn_params_t m_conn_params;
+
+static uint8_t m_flash[FLASH_SIZE];
+static bool m_flash_erased = false;
+static flash_module_t m_flash_modules[PSTORAGE_MODULES];
+static uint8_t m_flash_module_count = 0;
+static uint32_t m_flash_used = 0;
+static flash_op_t m_flash_ops[PSTORAGE_QUEUE_SIZE];
+static uint8_t m_flash_op_head = 0;
+static uint8_t m_flash_op_count = 0;
+static bool m_flash_busy = false;
+static uint32_t m_refuse_skip = 0;
+static uint32_t m_refuse_count = 0;
+static uint32_t m_fail_skip = 0;
+static uint32_t m_fail_count = 0;
+
+static void fatal(const char * p_reason){
+    fprintf(stderr, "sdk_host: %s\n", p_reason);
+    abort();
+}
+
+static attr_t * attr_get(uint16_t handle){
+    if(handle == 0 || handle > m_attr_count){
+        return NULL;
+    }
+    return &m_attrs[handle - 1];
+}
+
+static uint16_t attr_add(uint16_t uuid, const ble_gatts_attr_md_t * p_md, uint16_t init_len, uint16_t max_len, uint8_t * p_value){
+    attr_t * p_attr;
+
+    if(m_attr_count == ATTR_MAX){
+        fatal("attribute table full");
+    }
+    p_attr = &m_attrs[m_attr_count++];
+    memset(p_attr, 0, sizeof(*p_attr));
+
+    p_attr->uuid = uuid;
+    p_attr->len = init_len;
+    p_attr->max_len = max_len;
+    if(p_md){
+        p_attr->vlen = p_md->vlen;
+        p_attr->rd_auth = p_md->rd_auth;
+        if(p_md->vloc == BLE_GATTS_VLOC_USER){
+            p_attr->p_user = p_value;
+        }
+    }
+    if(p_attr->p_user == NULL){
+        if(max_len > ATTR_VALUE_MAX){
+            fatal("attribute too long for the stack");
+        }
+        if(p_value && init_len){
+            memcpy(p_attr->value, p_value, init_len);
+        }
+    }
+    return m_attr_count;
+}
+
+static uint8_t * attr_value(attr_t * p_attr){
+    return p_attr->p_user ? p_attr->p_user : p_attr->value;
+}
+
+static void ble_evt_deliver(void * p_evt){
+    if(m_ble_handler){
+        m_ble_handler((ble_evt_t *)p_evt);
+    }
+}
+
+static void link_reset(void){
+    m_connected = false;
+    m_disconnecting = false;
+    m_auth_pending = false;
+    m_tx_in_flight = 0;
+    m_tx_complete_scheduled = false;
+    m_link++;
+}
+
+static void tx_complete(void * p_context){
+    uint32_t buf[EVT_BUF_WORDS] = {0};
+    ble_evt_t * p_evt = (ble_evt_t *)buf;
+
+    if((uint32_t)(uintptr_t)p_context != m_link){
+        return;
+    }
+
+    p_evt->header.evt_id = BLE_EVT_TX_COMPLETE;
+    p_evt->header.evt_len = sizeof(ble_common_evt_t);
+    p_evt->evt.common_evt.conn_handle = m_conn_handle;
+    p_evt->evt.common_evt.params.tx_complete.count = m_tx_in_flight;
+    m_tx_in_flight = 0;
+    m_tx_complete_scheduled = false;
+
+    ble_evt_deliver(p_evt);
+}
+
+static void disconnect_complete(void * p_context){
+    uint32_t buf[EVT_BUF_WORDS] = {0};
+    ble_evt_t * p_evt = (ble_evt_t *)buf;
+
+    if((uint32_t)(uintptr_t)p_context != m_link){
+        return;
+    }
+
+    p_evt->header.evt_id = BLE_GAP_EVT_DISCONNECTED;
+    p_evt->header.evt_len = sizeof(ble_gap_evt_t);
+    p_evt->evt.gap_evt.conn_handle = m_conn_handle;
+    p_evt->evt.gap_evt.params.disconnected.reason = BLE_HCI_LOCAL_HOST_TERMINATED_CONNECTION;
+    link_reset();
+
+    ble_evt_deliver(p_evt);
+}
+
+void sdk_host_ble_handler_set(sdk_host_ble_evt_handler_t handler){
+    m_ble_handler = handler;
+}
+
+void sdk_host_hvx_handler_set(sdk_host_hvx_handler_t handler){
+    m_hvx_handler = handler;
+}
+
+uint16_t sdk_host_ble_connect(uint16_t conn_interval){
+    uint32_t buf[EVT_BUF_WORDS] = {0};
+    ble_evt_t * p_evt = (ble_evt_t *)buf;
+
+    if(m_connected){
+        fatal("already connected");
+    }
+
+    // A new peer without a bond starts with every CCCD cleared
+    for(uint16_t i = 0; i < m_attr_count; i++){
+        if(m_attrs[i].uuid == UUID_CCCD){
+            memset(m_attrs[i].value, 0, sizeof(m_attrs[i].value));
+        }
+    }
+
+    m_connected = true;
+    m_conn_handle = m_next_conn_handle++;
+    m_interval_ticks = ((uint64_t)conn_interval * 1250 * SDK_HOST_TICKS_PER_SECOND + 999999) / 1000000;
+    if(m_interval_ticks == 0){
+        m_interval_ticks = 1;
+    }
+    m_conn_params.min_conn_interval = conn_interval;
+    m_conn_params.max_conn_interval = conn_interval;
+    m_conn_params.slave_latency = 0;
+
+    p_evt->header.evt_id = BLE_GAP_EVT_CONNECTED;
+    p_evt->header.evt_len = sizeof(ble_gap_evt_t);
+    p_evt->evt.gap_evt.conn_handle = m_conn_handle;
+    p_evt->evt.gap_evt.params.connected.conn_params = m_conn_params;
+    sdk_host_evt_post(ble_evt_deliver, NULL, buf, sizeof(buf));
+
+    return m_conn_handle;
+}
+
+void sdk_host_ble_peer_disconnect(void){
+    uint32_t buf[EVT_BUF_WORDS] = {0};
+    ble_evt_t * p_evt = (ble_evt_t *)buf;
+
+    if(!m_connected){
+        fatal("not connected");
+    }
+
+    p_evt->header.evt_id = BLE_GAP_EVT_DISCONNECTED;
+    p_evt->header.evt_len = sizeof(ble_gap_evt_t);
+    p_evt->evt.gap_evt.conn_handle = m_conn_handle;
+    p_evt->evt.gap_evt.params.disconnected.reason = BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION;
+    link_reset();
+
+    sdk_host_evt_post(ble_evt_deliver, NULL, buf, sizeof(buf));
+}
+
+bool sdk_host_ble_connected(void){
+    return m_connected;
+}
+
+uint32_t sdk_host_ble_write(uint16_t handle, uint8_t op, uint16_t offset, const void * p_data, uint16_t len){
+    uint32_t buf[EVT_BUF_WORDS] = {0};
+    ble_evt_t * p_evt = (ble_evt_t *)buf;
+    ble_gatts_evt_write_t * p_write = &p_evt->evt.gatts_evt.params.write;
+    attr_t * p_attr = attr_get(handle);
+
+    if(!m_connected){
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if(p_attr == NULL){
+        return BLE_ERROR_INVALID_ATTR_HANDLE;
+    }
+    if(len > SDK_HOST_ATT_MAX_WRITE || offsetof(ble_evt_t, evt.gatts_evt.params.write.data) + len > sizeof(buf)){
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    // The stack stores whole writes before telling the application
+    if(op == BLE_GATTS_OP_WRITE_REQ || op == BLE_GATTS_OP_WRITE_CMD){
+        if(p_attr->p_user || offset + len > p_attr->max_len){
+            return NRF_ERROR_INVALID_LENGTH;
+        }
+        memcpy(&p_attr->value[offset], p_data, len);
+        if(p_attr->vlen || offset + len > p_attr->len){
+            p_attr->len = offset + len;
+        }
+    }
+
+    p_evt->header.evt_id = BLE_GATTS_EVT_WRITE;
+    p_evt->header.evt_len = offsetof(ble_gatts_evt_t, params.write.data) + len;
+    p_evt->evt.gatts_evt.conn_handle = m_conn_handle;
+    p_write->handle = handle;
+    p_write->op = op;
+    p_write->offset = offset;
+    p_write->len = len;
+    memcpy(p_write->data, p_data, len);
+    sdk_host_evt_post(ble_evt_deliver, NULL, buf, sizeof(buf));
+
+    return NRF_SUCCESS;
+}
+
+uint16_t sdk_host_ble_read(uint16_t handle, uint16_t offset, void * p_out, uint16_t size){
+    attr_t * p_attr = attr_get(handle);
+    uint16_t len;
+
+    if(!m_connected || p_attr == NULL || offset > p_attr->len){
+        return 0;
+    }
+
+    if(p_attr->rd_auth){
+        uint32_t buf[EVT_BUF_WORDS] = {0};
+        ble_evt_t * p_evt = (ble_evt_t *)buf;
+
+        p_evt->header.evt_id = BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST;
+        p_evt->header.evt_len = sizeof(ble_gatts_evt_t);
+        p_evt->evt.gatts_evt.conn_handle = m_conn_handle;
+        p_evt->evt.gatts_evt.params.authorize_request.type = BLE_GATTS_AUTHORIZE_TYPE_READ;
+        p_evt->evt.gatts_evt.params.authorize_request.request.read.handle = handle;
+        p_evt->evt.gatts_evt.params.authorize_request.request.read.offset = offset;
+
+        m_auth_pending = true;
+        sdk_host_evt_post(ble_evt_deliver, NULL, buf, sizeof(buf));
+        if(m_auth_pending){
+            // Never answered, the peer would time out
+            m_auth_pending = false;
+            return 0;
+        }
+    }
+
+    len = p_attr->len - offset;
+    if(len > size){
+        len = size;
+    }
+    memcpy(p_out, attr_value(p_attr) + offset, len);
+    return len;
+}
+
+const ble_gap_conn_params_t * sdk_host_ble_conn_params(void){
+    return &m_conn_params;
+}
+
+/*
+ *  SoftDevice calls
+ */
+
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const * p_vs_uuid, uint8_t * p_uuid_type){
+    (void)p_vs_uuid;
+    *p_uuid_type = BLE_UUID_TYPE_VENDOR_BEGIN + m_vs_uuid_count++;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_user_mem_reply(uint16_t conn_handle, ble_user_mem_block_t const * p_block){
+    (void)p_block;
+    if(!m_connected || conn_handle != m_conn_handle){
+        return BLE_ERROR_INVALID_CONN_HANDLE;
+    }
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gap_disconnect(uint16_t conn_handle, uint8_t hci_status_code){
+    (void)hci_status_code;
+
+    if(!m_connected || conn_handle != m_conn_handle){
+        return BLE_ERROR_INVALID_CONN_HANDLE;
+    }
+    if(m_disconnecting){
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    // Takes effect at the next connection event
+    m_disconnecting = true;
+    sdk_host_at(sdk_host_now() + m_interval_ticks, disconnect_complete, (void *)(uintptr_t)m_link);
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const * p_uuid, uint16_t * p_handle){
+    (void)type;
+    *p_handle = attr_add(0x2800, NULL, 2, 2, (uint8_t *)&p_uuid->uuid);
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_characteristic_add(uint16_t service_handle, ble_gatts_char_md_t const * p_char_md, ble_gatts_attr_t const * p_attr_char_value, ble_gatts_char_handles_t * p_handles){
+    (void)service_handle;
+
+    attr_add(0x2803, NULL, 0, 0, NULL);
+    p_handles->value_handle = attr_add(p_attr_char_value->p_uuid->uuid, p_attr_char_value->p_attr_md,
+                                       p_attr_char_value->init_len, p_attr_char_value->max_len,
+                                       p_attr_char_value->p_value);
+    p_handles->user_desc_handle = BLE_GATT_HANDLE_INVALID;
+    p_handles->cccd_handle = BLE_GATT_HANDLE_INVALID;
+    p_handles->sccd_handle = BLE_GATT_HANDLE_INVALID;
+
+    if(p_char_md->p_cccd_md){
+        uint8_t cccd[2] = {0, 0};
+
+        p_handles->cccd_handle = attr_add(UUID_CCCD, p_char_md->p_cccd_md, sizeof(cccd), sizeof(cccd), cccd);
+    }
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_descriptor_add(uint16_t char_handle, ble_gatts_attr_t const * p_attr, uint16_t * p_handle){
+    (void)char_handle;
+    *p_handle = attr_add(p_attr->p_uuid->uuid, p_attr->p_attr_md, p_attr->init_len, p_attr->max_len, p_attr->p_value);
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_value_set(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value){
+    attr_t * p_attr = attr_get(handle);
+
+    (void)conn_handle;
+    if(p_attr == NULL){
+        return BLE_ERROR_INVALID_ATTR_HANDLE;
+    }
+    if(p_value->offset + p_value->len > p_attr->max_len){
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    memcpy(attr_value(p_attr) + p_value->offset, p_value->p_value, p_value->len);
+    p_attr->len = p_value->offset + p_value->len;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params){
+    attr_t * p_attr = attr_get(p_hvx_params->handle);
+    attr_t * p_cccd = attr_get(p_hvx_params->handle + 1);
+    uint16_t len = *p_hvx_params->p_len;
+
+    if(!m_connected || conn_handle != m_conn_handle){
+        return BLE_ERROR_INVALID_CONN_HANDLE;
+    }
+    if(p_attr == NULL){
+        return BLE_ERROR_INVALID_ATTR_HANDLE;
+    }
+    if(p_cccd == NULL || p_cccd->uuid != UUID_CCCD || !(p_cccd->value[0] & 0x01)){
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if(m_tx_in_flight == SDK_HOST_TX_BUFFERS){
+        return BLE_ERROR_NO_TX_BUFFERS;
+    }
+
+    if(p_hvx_params->p_data){
+        ble_gatts_value_t value = { .len = len, .offset = p_hvx_params->offset, .p_value = p_hvx_params->p_data };
+        uint32_t err_code = sd_ble_gatts_value_set(conn_handle, p_hvx_params->handle, &value);
+
+        if(err_code != NRF_SUCCESS){
+            return err_code;
+        }
+    }
+
+    m_tx_in_flight++;
+    if(!m_tx_complete_scheduled){
+        m_tx_complete_scheduled = true;
+        sdk_host_at(sdk_host_now() + m_interval_ticks, tx_complete, (void *)(uintptr_t)m_link);
+    }
+
+    if(m_hvx_handler){
+        m_hvx_handler(p_hvx_params->handle, attr_value(p_attr), len);
+    }
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ble_gatts_rw_authorize_reply(uint16_t conn_handle, ble_gatts_rw_authorize_reply_params_t const * p_rw_authorize_reply_params){
+    (void)p_rw_authorize_reply_params;
+
+    if(!m_connected || conn_handle != m_conn_handle){
+        return BLE_ERROR_INVALID_CONN_HANDLE;
+    }
+    if(!m_auth_pending){
+        return NRF_ERROR_INVALID_STATE;
+    }
+    m_auth_pending = false;
+    return NRF_SUCCESS;
+}
+
+uint8_t ble_srv_report_ref_encode(uint8_t * p_encoded_buffer, const ble_srv_report_ref_t * p_report_ref){
+    p_encoded_buffer[0] = p_report_ref->report_id;
+    p_encoded_buffer[1] = p_report_ref->report_type;
+    return BLE_SRV_ENCODED_REPORT_REF_LEN;
+}
+
+uint32_t ble_conn_params_change_conn_params(ble_gap_conn_params_t * new_params){
+    m_conn_params = *new_params;
+    return NRF_SUCCESS;
+}
+
+/*
+ *  pstorage
+ */
+
+static void flash_erase_once(void){
+    if(!m_flash_erased){
+        memset(m_flash, 0xFF, sizeof(m_flash));
+        m_flash_erased = true;
+    }
+}
+
+static bool flash_range_valid(const pstorage_handle_t * p_handle, uint32_t size, uint32_t offset){
+    return p_handle->module_id < m_flash_module_count && p_handle->block_id + offset + size <= m_flash_used;
+}
+
+static void flash_op_done(void * p_context);
+
+// About 46 us per word programmed and 22 ms per page erased, as on the nRF51
+static void flash_op_start(void){
+    flash_op_t * p_op = &m_flash_ops[m_flash_op_head];
+    uint64_t ticks;
+
+    if(m_flash_busy || m_flash_op_count == 0){
+        return;
+    }
+    m_flash_busy = true;
+
+    if(p_op->op_code == PSTORAGE_CLEAR_OP_CODE){
+        ticks = SDK_HOST_MS(22) * ((p_op->size + PSTORAGE_FLASH_PAGE_SIZE - 1) / PSTORAGE_FLASH_PAGE_SIZE);
+    } else {
+        ticks = 1 + ((uint64_t)p_op->size / 4 * 46 * SDK_HOST_TICKS_PER_SECOND) / 1000000;
+    }
+    sdk_host_at(sdk_host_now() + ticks, flash_op_done, NULL);
+}
+
+static void flash_op_done(void * p_context){
+    flash_op_t op;
+    uint32_t address;
+    uint32_t result = NRF_SUCCESS;
+
+    (void)p_context;
+
+    CRITICAL_REGION_ENTER();
+    op = m_flash_ops[m_flash_op_head];
+    m_flash_op_head = (m_flash_op_head + 1) % PSTORAGE_QUEUE_SIZE;
+    m_flash_op_count--;
+    m_flash_busy = false;
+    CRITICAL_REGION_EXIT();
+
+    address = op.handle.block_id + op.offset;
+    if(op.fail){
+        // What pstorage reports when the SoftDevice gave up on the operation
+        result = NRF_ERROR_TIMEOUT;
+    } else if(op.op_code == PSTORAGE_CLEAR_OP_CODE){
+        memset(&m_flash[address], 0xFF, op.size);
+    } else {
+        // Programming only clears bits
+        for(uint32_t i = 0; i < op.size; i++){
+            m_flash[address + i] &= op.p_src[i];
+        }
+    }
+
+    m_flash_modules[op.handle.module_id].cb(&op.handle, op.op_code, result, op.p_src, op.size);
+
+    CRITICAL_REGION_ENTER();
+    flash_op_start();
+    CRITICAL_REGION_EXIT();
+}
+
+static uint32_t flash_op_queue(uint8_t op_code, pstorage_handle_t * p_handle, uint8_t * p_src, pstorage_size_t size, pstorage_size_t offset){
+    uint32_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if(m_refuse_count && m_refuse_skip == 0){
+        m_refuse_count--;
+        err_code = NRF_ERROR_NO_MEM;
+    } else if(m_flash_op_count == PSTORAGE_QUEUE_SIZE){
+        err_code = NRF_ERROR_NO_MEM;
+    } else {
+        flash_op_t * p_op = &m_flash_ops[(m_flash_op_head + m_flash_op_count) % PSTORAGE_QUEUE_SIZE];
+
+        if(m_refuse_skip){
+            m_refuse_skip--;
+        }
+        p_op->op_code = op_code;
+        p_op->handle = *p_handle;
+        p_op->p_src = p_src;
+        p_op->size = size;
+        p_op->offset = offset;
+        p_op->fail = false;
+        if(m_fail_skip){
+            m_fail_skip--;
+        } else if(m_fail_count){
+            m_fail_count--;
+            p_op->fail = true;
+        }
+        m_flash_op_count++;
+        flash_op_start();
+    }
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+uint32_t pstorage_init(void){
+    flash_erase_once();
+    return NRF_SUCCESS;
+}
+
+uint32_t pstorage_register(pstorage_module_param_t * p_module_param, pstorage_handle_t * p_block_id){
+    uint32_t size = (uint32_t)p_module_param->block_size * p_module_param->block_count;
+    flash_module_t * p_module;
+
+    flash_erase_once();
+    size = (size + PSTORAGE_FLASH_PAGE_SIZE - 1) / PSTORAGE_FLASH_PAGE_SIZE * PSTORAGE_FLASH_PAGE_SIZE;
+    if(m_flash_module_count == PSTORAGE_MODULES || m_flash_used + size > FLASH_SIZE){
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_module = &m_flash_modules[m_flash_module_count];
+    p_module->cb = p_module_param->cb;
+    p_module->base = m_flash_used;
+    p_module->block_size = p_module_param->block_size;
+    p_module->block_count = p_module_param->block_count;
+
+    p_block_id->module_id = m_flash_module_count++;
+    p_block_id->block_id = m_flash_used;
+    m_flash_used += size;
+    return NRF_SUCCESS;
+}
+
+uint32_t pstorage_block_identifier_get(pstorage_handle_t * p_base_id, pstorage_size_t block_num, pstorage_handle_t * p_block_id){
+    flash_module_t * p_module;
+
+    if(p_base_id->module_id >= m_flash_module_count){
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    p_module = &m_flash_modules[p_base_id->module_id];
+    if(block_num >= p_module->block_count){
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_block_id->module_id = p_base_id->module_id;
+    p_block_id->block_id = p_module->base + (uint32_t)block_num * p_module->block_size;
+    return NRF_SUCCESS;
+}
+
+uint32_t pstorage_store(pstorage_handle_t * p_dest, uint8_t * p_src, pstorage_size_t size, pstorage_size_t offset){
+    if(!flash_range_valid(p_dest, size, offset) || size == 0){
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if((size | offset) & 3){
+        return NRF_ERROR_INVALID_ADDR;
+    }
+    return flash_op_queue(PSTORAGE_STORE_OP_CODE, p_dest, p_src, size, offset);
+}
+
+uint32_t pstorage_load(uint8_t * p_dest, pstorage_handle_t * p_src, pstorage_size_t size, pstorage_size_t offset){
+    if(!flash_range_valid(p_src, size, offset)){
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    memcpy(p_dest, &m_flash[p_src->block_id + offset], size);
+    return NRF_SUCCESS;
+}
+
+uint32_t pstorage_clear(pstorage_handle_t * p_base_id, pstorage_size_t size){
+    if(!flash_range_valid(p_base_id, size, 0)){
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    return flash_op_queue(PSTORAGE_CLEAR_OP_CODE, p_base_id, NULL, size, 0);
+}
+
+uint8_t * sdk_host_flash(void){
+    flash_erase_once();
+    return m_flash;
+}
+
+uint32_t sdk_host_flash_ops_pending(void){
+    return m_flash_op_count;
+}
+
+void sdk_host_flash_refuse(uint32_t skip, uint32_t count){
+    m_refuse_skip = skip;
+    m_refuse_count = count;
+}
+
+void sdk_host_flash_fail(uint32_t skip, uint32_t count){
+    m_fail_skip = skip;
+    m_fail_count = count;
+}
@@ -0,0 +1,44 @@
+/*
+ *  Host SDK Emulation, the peer side of the SoftDevice
+ *
+ *  What a phone and the flash would do to the firmware. Calls made from the
+ *  main loop with interrupts enabled deliver their event before returning.
+ *  Notifications use one of SDK_HOST_TX_BUFFERS and are confirmed with
+ *  BLE_EVT_TX_COMPLETE one connection interval later.
+ */
+
+#ifndef SDK_HOST_BLE_H__
+#define SDK_HOST_BLE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble.h"
+#include "pstorage.h"
+
+#define SDK_HOST_TX_BUFFERS 7
+#define SDK_HOST_ATT_MAX_WRITE 20                  // Default ATT MTU less the opcode and handle
+#define SDK_HOST_FLASH_PAGES 8
+
+typedef void (*sdk_host_ble_evt_handler_t)(ble_evt_t * p_ble_evt);
+typedef void (*sdk_host_hvx_handler_t)(uint16_t handle, const uint8_t * p_data, uint16_t len);
+
+void sdk_host_ble_handler_set(sdk_host_ble_evt_handler_t handler);
+void sdk_host_hvx_handler_set(sdk_host_hvx_handler_t handler);
+
+uint16_t sdk_host_ble_connect(uint16_t conn_interval);     // In 1.25 ms units, returns the connection handle
+void sdk_host_ble_peer_disconnect(void);
+bool sdk_host_ble_connected(void);
+uint32_t sdk_host_ble_write(uint16_t handle, uint8_t op, uint16_t offset, const void * p_data, uint16_t len);
+uint16_t sdk_host_ble_read(uint16_t handle, uint16_t offset, void * p_out, uint16_t size);
+const ble_gap_conn_params_t * sdk_host_ble_conn_params(void);
+
+// Flash behind pstorage, erased to 0xFF. The next count stores and clears
+// after skip more are refused with NRF_ERROR_NO_MEM, as with a full queue.
+// sdk_host_flash_fail() has them accepted instead, and then completed with
+// NRF_ERROR_TIMEOUT without touching the flash.
+uint8_t * sdk_host_flash(void);
+uint32_t sdk_host_flash_ops_pending(void);
+void sdk_host_flash_refuse(uint32_t skip, uint32_t count);
+void sdk_host_flash_fail(uint32_t skip, uint32_t count);
+
+#endif
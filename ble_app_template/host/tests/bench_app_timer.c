@@ -0,0 +1,280 @@
+/*
+ *  Cost of starting, stopping and restarting one timer with 6 to 32 others
+ *  running, the case a timer wheel or min-heap backend for app_timer would
+ *  be for. Three rows per count:
+ *
+ *  app_timer       the real thing, a queued operation and the SWI0 pass
+ *                  that applies it to the sorted delta list
+ *  delta list      timer_list_insert() and timer_list_remove() on their own
+ *  min-heap        the same operations on a binary heap of deadlines, with
+ *                  each timer's position kept for O(log n) removal
+ *
+ *  The list is O(n) and the heap O(log n), but at these counts the walk is
+ *  a small part of what app_timer costs per operation. Host timings only
+ *  rank the backends; on the target every figure is many times larger.
+ */
+
+#include <time.h>
+#include "phone.h"
+#include "sdk_host.h"
+#include "app_timer.h"
+
+#define TIMERS_MAX 32
+#define OPS 20000
+#define TIMEOUT_MIN APP_TIMER_TICKS(100, 0)
+#define TIMEOUT_SPAN APP_TIMER_TICKS(300000, 0)   // Up to 5 minutes, well inside half the RTC range
+
+static const uint32_t m_counts[] = { 6, 8, 12, 16, 24, 32 };
+
+static uint64_t m_app_timer_buf[1024];
+static app_timer_id_t m_ids[TIMERS_MAX];
+static uint32_t m_rand = 1;
+
+static uint64_t nanoseconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+// xorshift32, the same timeouts and picks for every backend
+static uint32_t rand_next(void){
+    m_rand ^= m_rand << 13;
+    m_rand ^= m_rand >> 17;
+    m_rand ^= m_rand << 5;
+    return m_rand;
+}
+
+static uint32_t timeout_next(void){
+    return TIMEOUT_MIN + rand_next() % TIMEOUT_SPAN;
+}
+
+typedef struct {
+    void (*init)(uint32_t count);              // count timers running
+    void (*start)(uint32_t index, uint32_t timeout);
+    void (*stop)(uint32_t index);
+    void (*restart)(uint32_t index, uint32_t timeout);
+} backend_t;
+
+/*
+ *  app_timer. Time doesn't move, so nothing expires while it is measured.
+ */
+
+static void timeout_handler(void * p_context){
+    (void)p_context;
+    CHECK(false);
+}
+
+static void app_timer_bench_init(uint32_t count){
+    static bool created;
+
+    if(!created){
+        CHECK(app_timer_init(0, TIMERS_MAX, 4, (uint32_t*)m_app_timer_buf, NULL) == NRF_SUCCESS);
+        for(uint32_t i = 0; i < TIMERS_MAX; i++){
+            CHECK(app_timer_create(&m_ids[i], APP_TIMER_MODE_SINGLE_SHOT, timeout_handler) == NRF_SUCCESS);
+        }
+        created = true;
+    }
+    CHECK(app_timer_stop_all() == NRF_SUCCESS);
+    for(uint32_t i = 0; i < count; i++){
+        CHECK(app_timer_start(m_ids[i], timeout_next(), NULL) == NRF_SUCCESS);
+    }
+}
+
+static void app_timer_bench_start(uint32_t index, uint32_t timeout){
+    CHECK(app_timer_start(m_ids[index], timeout, NULL) == NRF_SUCCESS);
+}
+
+static void app_timer_bench_stop(uint32_t index){
+    CHECK(app_timer_stop(m_ids[index]) == NRF_SUCCESS);
+}
+
+static void app_timer_bench_restart(uint32_t index, uint32_t timeout){
+    CHECK(app_timer_restart(m_ids[index], timeout, NULL) == NRF_SUCCESS);
+}
+
+/*
+ *  Delta list, as app_timer.c keeps it: each node holds the ticks after the
+ *  one before it.
+ */
+
+#define NONE 0xFF
+
+static struct {
+    uint32_t ticks_to_expire;
+    uint8_t next;
+} m_list[TIMERS_MAX];
+static uint8_t m_list_head;
+
+static void list_insert(uint32_t index, uint32_t ticks_to_expire){
+    uint8_t previous = NONE;
+    uint8_t current = m_list_head;
+
+    while(current != NONE && ticks_to_expire > m_list[current].ticks_to_expire){
+        ticks_to_expire -= m_list[current].ticks_to_expire;
+        previous = current;
+        current = m_list[current].next;
+    }
+    if(current != NONE){
+        m_list[current].ticks_to_expire -= ticks_to_expire;
+    }
+    m_list[index].ticks_to_expire = ticks_to_expire;
+    m_list[index].next = current;
+    if(previous == NONE){
+        m_list_head = index;
+    } else {
+        m_list[previous].next = index;
+    }
+}
+
+static void list_remove(uint32_t index){
+    uint8_t previous = NONE;
+    uint8_t current = m_list_head;
+
+    while(current != index){
+        previous = current;
+        current = m_list[current].next;
+    }
+    if(m_list[index].next != NONE){
+        m_list[m_list[index].next].ticks_to_expire += m_list[index].ticks_to_expire;
+    }
+    if(previous == NONE){
+        m_list_head = m_list[index].next;
+    } else {
+        m_list[previous].next = m_list[index].next;
+    }
+}
+
+static void list_init(uint32_t count){
+    m_list_head = NONE;
+    for(uint32_t i = 0; i < count; i++){
+        list_insert(i, timeout_next());
+    }
+}
+
+static void list_restart(uint32_t index, uint32_t timeout){
+    list_remove(index);
+    list_insert(index, timeout);
+}
+
+static void list_start(uint32_t index, uint32_t timeout){
+    list_insert(index, timeout);
+}
+
+/*
+ *  Min-heap of absolute deadlines. Virtual time stands still here too, so a
+ *  deadline is just the timeout.
+ */
+
+static uint32_t m_heap[TIMERS_MAX];            // Timer indices, earliest deadline first
+static uint32_t m_heap_size;
+static uint32_t m_deadline[TIMERS_MAX];
+static uint32_t m_position[TIMERS_MAX];
+
+static void heap_place(uint32_t position, uint32_t index){
+    m_heap[position] = index;
+    m_position[index] = position;
+}
+
+static void heap_sift(uint32_t position){
+    uint32_t index = m_heap[position];
+
+    while(position > 0 && m_deadline[m_heap[(position - 1) / 2]] > m_deadline[index]){
+        heap_place(position, m_heap[(position - 1) / 2]);
+        position = (position - 1) / 2;
+    }
+    for(;;){
+        uint32_t child = 2 * position + 1;
+
+        if(child >= m_heap_size){
+            break;
+        }
+        if(child + 1 < m_heap_size && m_deadline[m_heap[child + 1]] < m_deadline[m_heap[child]]){
+            child++;
+        }
+        if(m_deadline[m_heap[child]] >= m_deadline[index]){
+            break;
+        }
+        heap_place(position, m_heap[child]);
+        position = child;
+    }
+    heap_place(position, index);
+}
+
+static void heap_start(uint32_t index, uint32_t timeout){
+    m_deadline[index] = timeout;
+    heap_place(m_heap_size++, index);
+    heap_sift(m_heap_size - 1);
+}
+
+static void heap_stop(uint32_t index){
+    uint32_t position = m_position[index];
+
+    m_heap_size--;
+    if(position != m_heap_size){
+        heap_place(position, m_heap[m_heap_size]);
+        heap_sift(position);
+    }
+}
+
+static void heap_restart(uint32_t index, uint32_t timeout){
+    m_deadline[index] = timeout;
+    heap_sift(m_position[index]);
+}
+
+static void heap_init(uint32_t count){
+    m_heap_size = 0;
+    for(uint32_t i = 0; i < count; i++){
+        heap_start(i, timeout_next());
+    }
+}
+
+static const backend_t m_app_timer = { app_timer_bench_init, app_timer_bench_start, app_timer_bench_stop, app_timer_bench_restart };
+static const backend_t m_list_backend = { list_init, list_start, list_remove, list_restart };
+static const backend_t m_heap_backend = { heap_init, heap_start, heap_stop, heap_restart };
+
+// Each round stops a random running timer, starts it again and restarts
+// another, so count timers stay running throughout. The worst is the
+// slowest single operation of the lot, host interruptions included.
+static void bench(const char * p_name, const backend_t * p_backend, uint32_t count){
+    uint64_t took[3] = { 0 };
+    uint64_t worst = 0;
+
+    m_rand = 1;
+    p_backend->init(count);
+    for(uint32_t i = 0; i < OPS; i++){
+        uint32_t index = rand_next() % count;
+        uint32_t timeout = timeout_next();
+        uint32_t other = rand_next() % count;
+        uint32_t restart_timeout = timeout_next();
+        uint64_t t0, t1, t2, t3;
+
+        t0 = nanoseconds();
+        p_backend->stop(index);
+        t1 = nanoseconds();
+        p_backend->start(index, timeout);
+        t2 = nanoseconds();
+        p_backend->restart(other, restart_timeout);
+        t3 = nanoseconds();
+
+        uint64_t op[3] = { t1 - t0, t2 - t1, t3 - t2 };
+        for(int j = 0; j < 3; j++){
+            took[j] += op[j];
+            if(op[j] > worst){
+                worst = op[j];
+            }
+        }
+    }
+
+    printf("%2u timers  %-10s  start %6.1f ns  stop %6.1f ns  restart %6.1f ns  worst %6llu ns\n",
+           count, p_name, (double)took[1] / OPS, (double)took[0] / OPS, (double)took[2] / OPS,
+           (unsigned long long)worst);
+}
+
+int main(void){
+    for(uint32_t i = 0; i < sizeof(m_counts) / sizeof(m_counts[0]); i++){
+        bench("app_timer", &m_app_timer, m_counts[i]);
+        bench("delta list", &m_list_backend, m_counts[i]);
+        bench("min-heap", &m_heap_backend, m_counts[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,221 @@
+/*
+ *  Fuzzer for everything a phone can send over the air
+ *
+ *  Each input is a script of one byte operations, read from the front, with
+ *  their arguments in the bytes after them (missing bytes read as 0):
+ *
+ *    0 CONNECT      interval         Connects at 6 + 4 * interval (1.25 ms units)
+ *    1 DISCONNECT                    The phone drops the link
+ *    2 WRITE        handle flags len data[len % 21]
+ *                                    Write through the stack, flags bit 0 picks
+ *                                    a write command and bits 1 to 7 the offset
+ *    3 RAW_WRITE    handle op offset len data[len % 33]
+ *                                    A BLE_GATTS_EVT_WRITE the stack would never
+ *                                    build, straight to the BOC service
+ *    4 RUN          ms               1 to 256 ms
+ *    5 RUN_LONG     s                1 to 256 s, for the time outs
+ *    6 READ         handle offset
+ *    7 SEED                          Writes the 4 words of a fixed key
+ *    8 PASSCODE     draw             Writes draw 1 to 64 of that key
+ *    9 COMMAND      draw opcode operand[4] seq
+ *
+ *  handle indexes the BOC value and CCCD handles, with handle 0 and the
+ *  invalid handle thrown in. Between inputs the phone disconnects, so every
+ *  input starts from ST_IDLE, but the device keeps its flash and its clock.
+ *
+ *  Built with Clang this is a libFuzzer target, otherwise fuzz_main.c
+ *  replays a corpus through it.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+#include "ble_boc.h"
+#include "prng.h"
+
+#define OP_COUNT 10
+#define RAW_WRITE_MAX 32                        // Past MAX_EVENT_DATA, the service has to refuse it
+#define DRAWS 64
+#define EVT_BUF_WORDS 16
+
+typedef struct {
+    const uint8_t * p_data;
+    size_t size;
+} input_t;
+
+static const uint64_t m_key[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                   0x2222222222222222ULL, 0x3333333333333333ULL };
+static uint64_t m_draws[DRAWS];
+static uint16_t m_handles[2 + 7 * 2];
+static uint8_t m_handle_count;
+static bool m_initialised = false;
+
+static uint8_t next(input_t * p_in){
+    uint8_t byte = 0;
+
+    if(p_in->size > 0){
+        byte = *p_in->p_data++;
+        p_in->size--;
+    }
+    return byte;
+}
+
+static void run_ms(uint32_t ms){
+    host_app_run_until(sdk_host_now() + SDK_HOST_MS(ms));
+}
+
+static void handles_add(const ble_gatts_char_handles_t * p_handles){
+    m_handles[m_handle_count++] = p_handles->value_handle;
+    m_handles[m_handle_count++] = p_handles->cccd_handle;
+}
+
+static void init(void){
+    ble_boc_t * p_boc;
+    uint64_t key[4];
+
+    // The generator is shared with the device, so the draws are worked out
+    // before it seeds it
+    memcpy(key, m_key, sizeof(key));
+    prng_seed(key, 4);
+    for(uint32_t i = 0; i < DRAWS; i++){
+        m_draws[i] = prng_next64();
+    }
+
+    host_app_init();
+    run_ms(10);
+
+    p_boc = host_app_boc();
+    m_handles[m_handle_count++] = 0;
+    m_handles[m_handle_count++] = BLE_GATT_HANDLE_INVALID;
+    handles_add(&p_boc->passcode_handles);
+    handles_add(&p_boc->opcode_handles);
+    handles_add(&p_boc->operand_handles);
+    handles_add(&p_boc->response_handles);
+    handles_add(&p_boc->command_handles);
+    handles_add(&p_boc->diag_handles);
+    handles_add(&p_boc->fr_handles);
+}
+
+static uint16_t handle_next(input_t * p_in){
+    return m_handles[next(p_in) % m_handle_count];
+}
+
+static void put_be64(uint8_t * p_out, uint64_t value){
+    for(int i = 0; i < 8; i++){
+        p_out[i] = value >> ((7 - i) * 8);
+    }
+}
+
+static void passcode_write(uint64_t passcode){
+    uint8_t frame[8];
+
+    put_be64(frame, passcode);
+    (void)sdk_host_ble_write(host_app_boc()->passcode_handles.value_handle, BLE_GATTS_OP_WRITE_REQ, 0, frame, sizeof(frame));
+}
+
+static void raw_write_deliver(void * p_evt){
+    ble_boc_on_ble_evt(host_app_boc(), (ble_evt_t *)p_evt);
+}
+
+static void raw_write(input_t * p_in){
+    uint32_t buf[EVT_BUF_WORDS] = {0};
+    ble_evt_t * p_evt = (ble_evt_t *)buf;
+    ble_gatts_evt_write_t * p_write = &p_evt->evt.gatts_evt.params.write;
+
+    p_write->handle = handle_next(p_in);
+    p_write->op = next(p_in);
+    p_write->offset = next(p_in);
+    p_write->len = next(p_in) % (RAW_WRITE_MAX + 1);
+    for(uint16_t i = 0; i < p_write->len; i++){
+        p_write->data[i] = next(p_in);
+    }
+
+    p_evt->header.evt_id = BLE_GATTS_EVT_WRITE;
+    p_evt->header.evt_len = offsetof(ble_gatts_evt_t, params.write.data) + p_write->len;
+    p_evt->evt.gatts_evt.conn_handle = host_app_conn_handle();
+    sdk_host_evt_post(raw_write_deliver, NULL, buf, sizeof(buf));
+}
+
+static void step(input_t * p_in){
+    uint8_t data[RAW_WRITE_MAX];
+    uint16_t handle;
+    uint8_t flags;
+    uint8_t len;
+
+    switch(next(p_in) % OP_COUNT){
+        case 0:
+            flags = next(p_in);
+            if(!sdk_host_ble_connected()){
+                sdk_host_ble_connect(6 + 4 * flags);
+            }
+            break;
+        case 1:
+            if(sdk_host_ble_connected()){
+                sdk_host_ble_peer_disconnect();
+            }
+            break;
+        case 2:
+            handle = handle_next(p_in);
+            flags = next(p_in);
+            len = next(p_in) % (SDK_HOST_ATT_MAX_WRITE + 1);
+            for(uint8_t i = 0; i < len; i++){
+                data[i] = next(p_in);
+            }
+            (void)sdk_host_ble_write(handle, (flags & 1) ? BLE_GATTS_OP_WRITE_CMD : BLE_GATTS_OP_WRITE_REQ,
+                                     flags >> 1, data, len);
+            break;
+        case 3:
+            raw_write(p_in);
+            break;
+        case 4:
+            run_ms(1 + next(p_in));
+            break;
+        case 5:
+            run_ms(1000 * (1 + (uint32_t)next(p_in)));
+            break;
+        case 6:
+            handle = handle_next(p_in);
+            (void)sdk_host_ble_read(handle, next(p_in), data, sizeof(data));
+            break;
+        case 7:
+            for(int i = 0; i < 4; i++){
+                passcode_write(m_key[i]);
+                run_ms(20);
+            }
+            break;
+        case 8:
+            passcode_write(m_draws[next(p_in) % DRAWS]);
+            break;
+        case 9:
+            put_be64(&data[0], m_draws[next(p_in) % DRAWS]);
+            for(int i = 8; i < 14; i++){
+                data[i] = next(p_in);
+            }
+            (void)sdk_host_ble_write(host_app_boc()->command_handles.value_handle, BLE_GATTS_OP_WRITE_REQ, 0, data, 14);
+            break;
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t * p_data, size_t size){
+    input_t in = { p_data, size };
+
+    if(!m_initialised){
+        init();
+        m_initialised = true;
+    }
+
+    while(in.size > 0){
+        step(&in);
+    }
+
+    // Back to ST_IDLE for the next input, with whatever was left pending run out
+    if(sdk_host_ble_connected()){
+        sdk_host_ble_peer_disconnect();
+    }
+    run_ms(200);
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ *  Corpus replay for the fuzz targets, for compilers without libFuzzer
+ *
+ *  fuzz_<target> <file or directory>... runs every input once through
+ *  LLVMFuzzerTestOneInput(), in name order within a directory, and reports
+ *  how many it got through per second.
+ */
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define INPUT_MAX 4096
+
+int LLVMFuzzerTestOneInput(const uint8_t * p_data, size_t size);
+
+static uint32_t m_inputs;
+static uint64_t m_bytes;
+
+static double seconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void run_file(const char * p_path){
+    static uint8_t data[INPUT_MAX];
+    FILE * p_file = fopen(p_path, "rb");
+    size_t size;
+
+    if(p_file == NULL){
+        perror(p_path);
+        exit(1);
+    }
+    size = fread(data, 1, sizeof(data), p_file);
+    fclose(p_file);
+
+    LLVMFuzzerTestOneInput(data, size);
+    m_inputs++;
+    m_bytes += size;
+}
+
+static int name_compare(const void * p_a, const void * p_b){
+    return strcmp(*(char * const *)p_a, *(char * const *)p_b);
+}
+
+static void run_dir(const char * p_path){
+    DIR * p_dir = opendir(p_path);
+    struct dirent * p_entry;
+    char ** pp_names = NULL;
+    size_t count = 0;
+    char path[1024];
+
+    if(p_dir == NULL){
+        perror(p_path);
+        exit(1);
+    }
+    while((p_entry = readdir(p_dir)) != NULL){
+        if(p_entry->d_name[0] == '.'){
+            continue;
+        }
+        pp_names = realloc(pp_names, (count + 1) * sizeof(*pp_names));
+        pp_names[count++] = strdup(p_entry->d_name);
+    }
+    closedir(p_dir);
+
+    qsort(pp_names, count, sizeof(*pp_names), name_compare);
+    for(size_t i = 0; i < count; i++){
+        snprintf(path, sizeof(path), "%s/%s", p_path, pp_names[i]);
+        run_file(path);
+        free(pp_names[i]);
+    }
+    free(pp_names);
+}
+
+int main(int argc, char ** argv){
+    struct stat info;
+    double start = seconds();
+    double elapsed;
+
+    for(int i = 1; i < argc; i++){
+        if(stat(argv[i], &info) != 0){
+            perror(argv[i]);
+            return 1;
+        }
+        if(S_ISDIR(info.st_mode)){
+            run_dir(argv[i]);
+        } else {
+            run_file(argv[i]);
+        }
+    }
+
+    elapsed = seconds() - start;
+    printf("%s: %u inputs, %llu bytes in %.3f s, %.0f inputs/s\n", argv[0], m_inputs,
+           (unsigned long long)m_bytes, elapsed, elapsed > 0 ? m_inputs / elapsed : 0.0);
+    return m_inputs > 0 ? 0 : 1;
+}
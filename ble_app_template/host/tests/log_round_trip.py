@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+"""
+Round trip of the deferred RTT log.
+
+Runs one host test built with the printf log and again built with
+LOG_DEFERRED, both with SDK_HOST_LOG set, decodes the deferred run's stream
+with rtt_log_decode.py and the deferred executable as the image, and checks
+the text matches the printf run's line for line. The printf log names files
+by their full path on the host, the decoder by their name alone, so paths
+are cut before comparing.
+
+Usage: log_round_trip.py <rtt_log_decode.py> <printf build> <deferred build>
+"""
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+LOCATION = re.compile(r"^(\s*\d+ \[(?: WARN|ERROR|FATAL)\] )\S*/([^/(]+\(\d+\): )")
+
+
+def run(path):
+    env = dict(os.environ, SDK_HOST_LOG="1")
+    return subprocess.run([path], stdout=subprocess.PIPE, env=env, check=True).stdout
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.stderr.write(__doc__)
+        return 1
+    decoder, printf_build, deferred_build = sys.argv[1:]
+
+    # Both runs end with the test's own summary line
+    expected = run(printf_build).decode("latin-1").splitlines()
+    summary = (expected.pop() + "\n").encode("latin-1")
+    stream = run(deferred_build)
+    if not stream.endswith(summary):
+        sys.stderr.write("deferred run did not end with %r\n" % summary)
+        return 1
+    stream = stream[:-len(summary)]
+
+    with tempfile.NamedTemporaryFile(suffix=".bin", delete=False) as capture:
+        capture.write(stream)
+    try:
+        decoded = subprocess.run([sys.executable, decoder, deferred_build, capture.name],
+                                 stdout=subprocess.PIPE, check=True).stdout
+    finally:
+        os.unlink(capture.name)
+    decoded = decoded.decode("latin-1").splitlines()
+    expected = [LOCATION.sub(r"\1\2", line) for line in expected]
+
+    for number, (got, wanted) in enumerate(zip(decoded, expected), 1):
+        if got != wanted:
+            sys.stderr.write("line %d: decoded %r, expected %r\n" % (number, got, wanted))
+            return 1
+    if len(decoded) != len(expected) or not expected:
+        sys.stderr.write("decoded %d lines, expected %d\n" % (len(decoded), len(expected)))
+        return 1
+
+    print("log round trip: %d records, %d bytes deferred, %d as text"
+          % (len(decoded), len(stream), sum(len(line) + 1 for line in expected)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
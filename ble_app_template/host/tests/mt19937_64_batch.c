@@ -0,0 +1,67 @@
+#include "mt19937_64_batch.h"
+
+// Same parameters as pca10028/s110/arm5/mt19937-64.c
+#define NN 200
+#define MM 156
+#define MATRIX_A 0xB5026F5AA96619E9ULL
+#define UM 0xFFFFFFFF80000000ULL
+#define LM 0x7FFFFFFFULL
+
+static uint64_t mt[NN];
+static int mti = NN + 1;
+
+void mt_batch_init_genrand64(uint64_t seed){
+    mt[0] = seed;
+    for(mti = 1; mti < NN; mti++){
+        mt[mti] = (6364136223846793005ULL * (mt[mti - 1] ^ (mt[mti - 1] >> 62)) + mti);
+    }
+}
+
+void mt_batch_init_by_array64(const uint64_t init_key[], uint64_t key_length){
+    uint64_t i, j, k;
+    mt_batch_init_genrand64(19650218ULL);
+    i = 1; j = 0;
+    k = (NN > key_length ? NN : key_length);
+    for(; k; k--){
+        mt[i] = (mt[i] ^ ((mt[i - 1] ^ (mt[i - 1] >> 62)) * 3935559000370003845ULL)) + init_key[j] + j;
+        i++; j++;
+        if(i >= NN){ mt[0] = mt[NN - 1]; i = 1; }
+        if(j >= key_length) j = 0;
+    }
+    for(k = NN - 1; k; k--){
+        mt[i] = (mt[i] ^ ((mt[i - 1] ^ (mt[i - 1] >> 62)) * 2862933555777941757ULL)) - i;
+        i++;
+        if(i >= NN){ mt[0] = mt[NN - 1]; i = 1; }
+    }
+    mt[0] = 1ULL << 63;
+}
+
+uint64_t mt_batch_int64(void){
+    int i;
+    uint64_t x;
+    static const uint64_t mag01[2] = { 0ULL, MATRIX_A };
+
+    if(mti >= NN){
+        if(mti == NN + 1){
+            mt_batch_init_genrand64(5489ULL);
+        }
+        for(i = 0; i < NN - MM; i++){
+            x = (mt[i] & UM) | (mt[i + 1] & LM);
+            mt[i] = mt[i + MM] ^ (x >> 1) ^ mag01[(int)(x & 1ULL)];
+        }
+        for(; i < NN - 1; i++){
+            x = (mt[i] & UM) | (mt[i + 1] & LM);
+            mt[i] = mt[i + (MM - NN)] ^ (x >> 1) ^ mag01[(int)(x & 1ULL)];
+        }
+        x = (mt[NN - 1] & UM) | (mt[0] & LM);
+        mt[NN - 1] = mt[MM - 1] ^ (x >> 1) ^ mag01[(int)(x & 1ULL)];
+        mti = 0;
+    }
+
+    x = mt[mti++];
+    x ^= (x >> 29) & 0x5555555555555555ULL;
+    x ^= (x << 17) & 0x71D67FFFEDA60000ULL;
+    x ^= (x << 37) & 0xFFF7EEE000000000ULL;
+    x ^= (x >> 43);
+    return x;
+}
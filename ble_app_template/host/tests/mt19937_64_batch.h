@@ -0,0 +1,16 @@
+/*
+ *  MT19937-64 as it was before genrand64_int64() twisted one word per call:
+ *  the whole state is regenerated every NN outputs. Kept with its own state
+ *  as the reference the firmware generator has to match bit for bit.
+ */
+
+#ifndef MT19937_64_BATCH_H__
+#define MT19937_64_BATCH_H__
+
+#include <stdint.h>
+
+void mt_batch_init_genrand64(uint64_t seed);
+void mt_batch_init_by_array64(const uint64_t init_key[], uint64_t key_length);
+uint64_t mt_batch_int64(void);
+
+#endif
@@ -0,0 +1,112 @@
+#include "phone.h"
+#include <string.h>
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "host_app.h"
+#include "prng.h"
+
+static phone_response_t m_responses[PHONE_RESPONSES];
+static uint32_t m_response_count;
+
+static void on_hvx(uint16_t handle, const uint8_t * p_data, uint16_t len){
+    if(handle != host_app_boc()->response_handles.value_handle){
+        return;
+    }
+    CHECK(len <= sizeof(m_responses[0].data));
+    if(m_response_count < PHONE_RESPONSES){
+        memcpy(m_responses[m_response_count].data, p_data, len);
+        m_responses[m_response_count].len = len;
+    }
+    m_response_count++;
+}
+
+void phone_init(void){
+    sdk_host_hvx_handler_set(on_hvx);
+    host_app_init();
+    phone_run_ms(10);
+}
+
+void phone_run_ms(uint32_t ms){
+    host_app_run_until(sdk_host_now() + SDK_HOST_MS(ms));
+}
+
+void phone_connect(void){
+    static const uint8_t cccd_notify[2] = { 0x01, 0x00 };
+
+    sdk_host_ble_connect(PHONE_CONN_INTERVAL);
+    phone_run_ms(10);
+    CHECK(phone_write(host_app_boc()->response_handles.cccd_handle, cccd_notify, sizeof(cccd_notify)) == NRF_SUCCESS);
+    phone_run_ms(10);
+}
+
+void phone_disconnect(void){
+    sdk_host_ble_peer_disconnect();
+    phone_run_ms(20);
+}
+
+uint32_t phone_write(uint16_t handle, const void * p_data, uint16_t len){
+    return sdk_host_ble_write(handle, BLE_GATTS_OP_WRITE_REQ, 0, p_data, len);
+}
+
+static void put_be64(uint8_t * p_out, uint64_t value){
+    for(int i = 0; i < 8; i++){
+        p_out[i] = value >> ((7 - i) * 8);
+    }
+}
+
+void phone_passcode_write(uint64_t passcode){
+    uint8_t frame[8];
+    put_be64(frame, passcode);
+    CHECK(phone_write(host_app_boc()->passcode_handles.value_handle, frame, sizeof(frame)) == NRF_SUCCESS);
+}
+
+void phone_command(uint64_t passcode, uint8_t opcode, uint32_t operand, uint8_t seq){
+    uint8_t frame[14];
+    put_be64(&frame[0], passcode);
+    frame[8] = opcode;
+    frame[9] = operand >> 24;
+    frame[10] = operand >> 16;
+    frame[11] = operand >> 8;
+    frame[12] = operand;
+    frame[13] = seq;
+    CHECK(phone_write(host_app_boc()->command_handles.value_handle, frame, sizeof(frame)) == NRF_SUCCESS);
+}
+
+void phone_seed(const uint64_t seed[4], uint64_t * p_draws, uint32_t count){
+    uint64_t key[4];
+
+    // The generator is shared with the device, so the phone's copy is worked
+    // out before the device seeds it
+    memcpy(key, seed, sizeof(key));
+    prng_seed(key, 4);
+    for(uint32_t i = 0; i < count; i++){
+        p_draws[i] = prng_next64();
+    }
+
+    phone_responses_clear();
+    for(int i = 0; i < 4; i++){
+        phone_passcode_write(seed[i]);
+        phone_run_ms(20);
+    }
+    CHECK(phone_responses() == 4);
+    CHECK(phone_response(3)->len == 1 && phone_response(3)->data[0] == 2);
+    phone_responses_clear();
+}
+
+uint32_t phone_responses(void){
+    return m_response_count;
+}
+
+const phone_response_t * phone_response(uint32_t index){
+    CHECK(index < m_response_count && index < PHONE_RESPONSES);
+    return &m_responses[index];
+}
+
+const phone_response_t * phone_response_last(void){
+    CHECK(m_response_count > 0);
+    return phone_response(m_response_count - 1);
+}
+
+void phone_responses_clear(void){
+    m_response_count = 0;
+}
@@ -0,0 +1,47 @@
+/*
+ *  Phone side of the host tests
+ *
+ *  Drives the BOC service the way the app does, through the stand-in
+ *  SoftDevice, and keeps the response notifications it gets back.
+ */
+
+#ifndef PHONE_H__
+#define PHONE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond) do { if(!(cond)){ \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); } } while (0)
+
+#define PHONE_CONN_INTERVAL 8                   // 10 ms, the fast profile
+#define PHONE_RESPONSES 32
+
+typedef struct {
+    uint8_t data[20];
+    uint8_t len;
+} phone_response_t;
+
+void phone_init(void);                          // Host app and phone, no seed in flash
+void phone_connect(void);                       // Connects and turns on the response notifications
+void phone_disconnect(void);
+void phone_run_ms(uint32_t ms);
+
+uint32_t phone_write(uint16_t handle, const void * p_data, uint16_t len);
+void phone_passcode_write(uint64_t passcode);
+void phone_command(uint64_t passcode, uint8_t opcode, uint32_t operand, uint8_t seq);
+
+// Seeds the device with seed[4] and returns the passcodes it will accept as
+// draws 1 to count of the generator (p_draws[0] is draw 1)
+void phone_seed(const uint64_t seed[4], uint64_t * p_draws, uint32_t count);
+
+// Responses received since the last phone_responses_clear()
+uint32_t phone_responses(void);
+const phone_response_t * phone_response(uint32_t index);
+const phone_response_t * phone_response_last(void);
+void phone_responses_clear(void);
+
+#endif
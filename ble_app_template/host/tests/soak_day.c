@@ -0,0 +1,115 @@
+/*
+ *  A day in the field on virtual time. The device is seeded once and then
+ *  left to rotate its passcode every 30 s. Every 10 minutes a phone connects,
+ *  unlocks with the passcode it works out from its own clock and pulses the
+ *  starter; every hour one connects and just sits there until the 60 s
+ *  connection timeout drops it. All of it has to run in under a second.
+ *
+ *  soak_day [days] soaks for longer; only the one day run is timed.
+ */
+
+#include <time.h>
+#include "phone.h"
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+#include "custom_board.h"
+
+#define ROTATION_MS 30000
+#define SESSION_MS (10 * 60 * 1000)
+#define SESSIONS_PER_DAY (24 * 60 * 60 * 1000 / SESSION_MS)
+#define MAX_DAYS 7
+#define DRAWS (MAX_DAYS * 24 * 60 * 2 + 64)
+
+static const uint64_t m_seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                    0x2222222222222222ULL, 0x3333333333333333ULL };
+static uint64_t m_draws[DRAWS];
+static uint64_t m_seeded_at;
+static uint8_t m_seq;
+
+static double seconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// The passcode the phone expects from the time since it seeded the device
+static uint64_t phone_passcode(void){
+    uint64_t elapsed_ms = (sdk_host_now() - m_seeded_at) * 1000 / SDK_HOST_TICKS_PER_SECOND;
+    uint32_t draw = 2 + elapsed_ms / ROTATION_MS;
+    CHECK(draw <= DRAWS);
+    return m_draws[draw - 1];
+}
+
+static void session_start(void){
+    phone_run_ms(SESSION_MS - (uint32_t)((sdk_host_now() - m_seeded_at) * 1000 / SDK_HOST_TICKS_PER_SECOND) % SESSION_MS + 5000);
+    phone_connect();
+    CHECK(current_state_get() == ST_CONNECTED);
+}
+
+static void session_starter(void){
+    session_start();
+
+    phone_responses_clear();
+    phone_command(phone_passcode(), OP_STARTER, 1, m_seq);
+    phone_run_ms(20);
+    CHECK(phone_responses() == 1);
+    CHECK(phone_response_last()->data[0] == m_seq && phone_response_last()->data[1] == 5);
+    CHECK(current_state_get() == ST_UNLOCKED);
+    CHECK(sdk_host_gpio_out() & (1UL << LED_3));
+    m_seq++;
+
+    // The starter lets go by itself after 80 ms
+    phone_run_ms(100);
+    CHECK(!(sdk_host_gpio_out() & (1UL << LED_3)));
+
+    phone_disconnect();
+    CHECK(current_state_get() == ST_IDLE);
+}
+
+static void session_idle(void){
+    session_start();
+
+    phone_run_ms(59000);
+    CHECK(sdk_host_ble_connected());
+    phone_run_ms(2000);
+    CHECK(!sdk_host_ble_connected());
+    CHECK(current_state_get() == ST_IDLE);
+}
+
+static void soak(uint32_t days){
+    for(uint32_t session = 0; session < days * SESSIONS_PER_DAY; session++){
+        if(session % 6 == 5){
+            session_idle();
+        } else {
+            session_starter();
+        }
+    }
+}
+
+int main(int argc, char * argv[]){
+    uint32_t days = (argc > 1) ? (uint32_t)atoi(argv[1]) : 1;
+    double start;
+    double wall;
+
+    CHECK(days >= 1 && days <= MAX_DAYS);
+
+    phone_init();
+    phone_connect();
+    phone_seed(m_seed, m_draws, DRAWS);
+    m_seeded_at = sdk_host_now();
+    phone_disconnect();
+
+    start = seconds();
+    soak(days);
+    wall = seconds() - start;
+
+    CHECK(events_dropped() == 0);
+    printf("soak: %u day(s), %u sessions, %u rotations in %.3f s (%.0fx real time)\n",
+           days, days * SESSIONS_PER_DAY, days * 24 * 60 * 2, wall, days * 86400.0 / wall);
+    if(days == 1){
+        CHECK(wall < 1.0);
+    }
+    return 0;
+}
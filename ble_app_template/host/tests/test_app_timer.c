@@ -0,0 +1,50 @@
+/*
+ *  app_timer_restart() moves a running timer's timeout to a full interval
+ *  from now and starts a stopped one, in a single queued operation.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "app_timer.h"
+#include "app_error.h"
+
+#define INTERVAL APP_TIMER_TICKS(100, 0)
+
+static app_timer_id_t m_timer_id;
+static uint32_t m_fired;
+static uint64_t m_fired_at;
+
+static void timeout(void * p_context){
+    (void)p_context;
+    m_fired++;
+    m_fired_at = sdk_host_now();
+}
+
+int main(void){
+    uint64_t restarted_at;
+
+    phone_init();
+    CHECK(app_timer_create(&m_timer_id, APP_TIMER_MODE_SINGLE_SHOT, timeout) == NRF_SUCCESS);
+
+    // Stopped, so a restart just starts it
+    CHECK(app_timer_restart(m_timer_id, INTERVAL, NULL) == NRF_SUCCESS);
+    phone_run_ms(50);
+    CHECK(m_fired == 0);
+
+    // Running, pushed out to 100 ms from now
+    restarted_at = sdk_host_now();
+    CHECK(app_timer_restart(m_timer_id, INTERVAL, NULL) == NRF_SUCCESS);
+    phone_run_ms(80);
+    CHECK(m_fired == 0);
+    phone_run_ms(40);
+    CHECK(m_fired == 1);
+    CHECK(m_fired_at >= restarted_at + INTERVAL && m_fired_at <= restarted_at + INTERVAL + 1);
+
+    // Expired, started again
+    CHECK(app_timer_restart(m_timer_id, INTERVAL, NULL) == NRF_SUCCESS);
+    phone_run_ms(120);
+    CHECK(m_fired == 2);
+
+    printf("app timer restart: ok\n");
+    return 0;
+}
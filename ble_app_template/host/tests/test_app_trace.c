@@ -0,0 +1,84 @@
+/*
+ *  The UART trace, built with ENABLE_DEBUG_LOG_SUPPORT over the emulated
+ *  UART0: output that overruns the TX buffer is dropped and counted, and
+ *  once the buffer has room again the gap is marked with
+ *  "\r\n<N bytes dropped>\r\n" ahead of the next byte that goes out.
+ */
+
+#include <stdio.h>
+#include "phone.h"
+#include "sdk_host.h"
+#include "app_trace.h"
+
+#define BURST 400                               // Well over UART_TX_BUF_SIZE
+#define LINE_MAX 1024
+
+static uint8_t m_line[LINE_MAX];
+static uint32_t m_line_len;
+
+static void put(const char * p_text){
+    while(*p_text != '\0'){
+        app_trace_put((uint8_t)*p_text++);
+    }
+}
+
+// Lets the UART run for ms and keeps what came out of it
+static void drain_ms(uint32_t ms){
+    sdk_host_run_until(sdk_host_now() + SDK_HOST_MS(ms));
+    m_line_len += sdk_host_uart_tx(&m_line[m_line_len], LINE_MAX - m_line_len);
+    CHECK(m_line_len < LINE_MAX);
+}
+
+int main(void){
+    char report[32];
+    uint32_t dropped;
+    uint32_t sent;
+    uint32_t len;
+
+    app_trace_init();
+
+    // Nothing is lost while the output fits
+    put("trace\r\n");
+    drain_ms(10);
+    CHECK(m_line_len == 7 && memcmp(m_line, "trace\r\n", 7) == 0);
+    CHECK(app_trace_dropped_get() == 0);
+    m_line_len = 0;
+
+    // A burst the buffer can't hold keeps its head and loses its tail
+    for(uint32_t i = 0; i < BURST; i++){
+        app_trace_put('a' + i % 26);
+    }
+    dropped = app_trace_dropped_get();
+    CHECK(dropped > 0 && dropped < BURST);
+    sent = BURST - dropped;
+
+    // A few bytes later there is room for one more, but not for the report,
+    // so it's dropped too rather than hiding the gap
+    drain_ms(1);
+    put("x");
+    CHECK(app_trace_dropped_get() == dropped + 1);
+    dropped++;
+
+    // Drained, the report goes out ahead of the next line
+    drain_ms(100);
+    CHECK(m_line_len == sent);
+    put("next\r\n");
+    drain_ms(100);
+    CHECK(app_trace_dropped_get() == dropped);
+
+    for(uint32_t i = 0; i < sent; i++){
+        CHECK(m_line[i] == 'a' + i % 26);
+    }
+    len = (uint32_t)snprintf(report, sizeof(report), "\r\n<%u bytes dropped>\r\nnext\r\n", (unsigned)dropped);
+    CHECK(m_line_len == sent + len);
+    CHECK(memcmp(&m_line[sent], report, len) == 0);
+
+    // The count since app_trace_init() outlives the report
+    put("x");
+    drain_ms(10);
+    CHECK(app_trace_dropped_get() == dropped);
+    CHECK(m_line_len == sent + len + 1 && m_line[sent + len] == 'x');
+
+    printf("app trace: %u of %u bytes dropped, ok\n", (unsigned)dropped, BURST + 1);
+    return 0;
+}
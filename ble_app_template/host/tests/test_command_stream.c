@@ -0,0 +1,104 @@
+/*
+ *  A stream of command frames sent as Write Commands, the way the app
+ *  pipelines them. Frames that run are acknowledged with one cumulative
+ *  {seq, 5}. A frame lost to a full event queue leaves a gap: every frame
+ *  after it is answered {seq, -7} and doesn't run, until the phone resends
+ *  from the one that was lost.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+
+#define DRAWS 4
+
+static const uint64_t m_seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                    0x2222222222222222ULL, 0x3333333333333333ULL };
+static uint64_t m_draws[DRAWS];
+
+static void put_be64(uint8_t * p_out, uint64_t value){
+    for(int i = 0; i < 8; i++){
+        p_out[i] = value >> ((7 - i) * 8);
+    }
+}
+
+// OP_LOCK answers nothing of its own, so only the stream's responses come back
+static void stream(uint8_t first, uint8_t last){
+    for(uint32_t seq = first; seq <= last; seq++){
+        uint8_t frame[14];
+
+        put_be64(&frame[0], m_draws[1]);
+        frame[8] = OP_LOCK;
+        memset(&frame[9], 0, 4);
+        frame[12] = seq & 1;
+        frame[13] = seq;
+        CHECK(sdk_host_ble_write(host_app_boc()->command_handles.value_handle, BLE_GATTS_OP_WRITE_CMD, 0,
+                                 frame, sizeof(frame)) == NRF_SUCCESS);
+    }
+}
+
+static void response_expect(uint32_t index, const uint8_t * p_expected, uint8_t len){
+    CHECK(index < phone_responses());
+    CHECK(phone_response(index)->len == len);
+    CHECK(memcmp(phone_response(index)->data, p_expected, len) == 0);
+}
+
+int main(void){
+    phone_init();
+    phone_connect();
+    phone_seed(m_seed, m_draws, DRAWS);
+    phone_passcode_write(m_draws[1]);
+    phone_run_ms(20);
+    CHECK(current_state_get() == ST_UNLOCKED);
+
+    // A full queue of frames, acknowledged as one
+    phone_responses_clear();
+    stream(1, MAX_EVENTS);
+    phone_run_ms(50);
+    CHECK(phone_responses() == 1);
+    response_expect(0, (const uint8_t[]){ MAX_EVENTS, 5 }, 2);
+
+    // The queue fills before the main loop gets to it and the last two
+    // frames are lost. The two after them are refused.
+    phone_responses_clear();
+    stream(MAX_EVENTS + 1, 2 * MAX_EVENTS + 2);
+    phone_run_ms(50);
+    CHECK(phone_responses() == 1);
+    response_expect(0, (const uint8_t[]){ 2 * MAX_EVENTS, 5 }, 2);
+
+    phone_responses_clear();
+    stream(2 * MAX_EVENTS + 3, 2 * MAX_EVENTS + 4);
+    phone_run_ms(50);
+    CHECK(phone_responses() == 2);
+    response_expect(0, (const uint8_t[]){ 2 * MAX_EVENTS + 3, (uint8_t)-7 }, 2);
+    response_expect(1, (const uint8_t[]){ 2 * MAX_EVENTS + 4, (uint8_t)-7 }, 2);
+
+    // Resent from the first frame lost, and all of it runs
+    phone_responses_clear();
+    stream(2 * MAX_EVENTS + 1, 2 * MAX_EVENTS + 4);
+    phone_run_ms(50);
+    CHECK(phone_responses() == 1);
+    response_expect(0, (const uint8_t[]){ 2 * MAX_EVENTS + 4, 5 }, 2);
+
+    // A frame skipped outright is no different
+    phone_responses_clear();
+    stream(2 * MAX_EVENTS + 5, 2 * MAX_EVENTS + 6);
+    stream(2 * MAX_EVENTS + 8, 2 * MAX_EVENTS + 10);
+    phone_run_ms(50);
+    CHECK(phone_responses() == 3);
+    response_expect(0, (const uint8_t[]){ 2 * MAX_EVENTS + 6, 5, 2 * MAX_EVENTS + 8, (uint8_t)-7 }, 4);
+    response_expect(1, (const uint8_t[]){ 2 * MAX_EVENTS + 9, (uint8_t)-7 }, 2);
+    response_expect(2, (const uint8_t[]){ 2 * MAX_EVENTS + 10, (uint8_t)-7 }, 2);
+
+    phone_responses_clear();
+    stream(2 * MAX_EVENTS + 7, 2 * MAX_EVENTS + 10);
+    phone_run_ms(50);
+    CHECK(phone_responses() == 1);
+    response_expect(0, (const uint8_t[]){ 2 * MAX_EVENTS + 10, 5 }, 2);
+    CHECK(current_state_get() == ST_UNLOCKED);
+
+    printf("command stream: ok\n");
+    return 0;
+}
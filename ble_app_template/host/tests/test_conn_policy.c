@@ -0,0 +1,88 @@
+/*
+ *  The connection parameters the firmware asks for: fast while seeding,
+ *  slow once a connected phone has been quiet for CONN_POLICY_SLOW_DELAY,
+ *  and fast again from the first passcode, opcode, operand or command for
+ *  as long as they keep coming, unlocked or not.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+
+#define SLOW_DELAY_MS 5000                      // CONN_POLICY_SLOW_DELAY
+#define DRAWS 4
+
+static const uint64_t m_seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                    0x2222222222222222ULL, 0x3333333333333333ULL };
+static uint64_t m_draws[DRAWS];
+
+static bool fast(void){
+    const ble_gap_conn_params_t * p_params = sdk_host_ble_conn_params();
+    return p_params->max_conn_interval == PHONE_CONN_INTERVAL && p_params->slave_latency == 0;
+}
+
+static bool slow(void){
+    const ble_gap_conn_params_t * p_params = sdk_host_ble_conn_params();
+    return p_params->min_conn_interval > PHONE_CONN_INTERVAL && p_params->slave_latency > 0;
+}
+
+// Fast until the delay is nearly up, slow right after
+static void falls_back(void){
+    phone_run_ms(SLOW_DELAY_MS - 100);
+    CHECK(fast());
+    phone_run_ms(200);
+    CHECK(slow());
+}
+
+int main(void){
+    uint8_t opcode = OP_GET_MILLIS;
+    uint8_t operand[4] = { 0 };
+
+    phone_init();
+    phone_connect();
+    phone_seed(m_seed, m_draws, DRAWS);
+    CHECK(current_state_get() == ST_CONNECTED);
+    falls_back();
+
+    // A quiet phone stays slow
+    phone_run_ms(30000);
+    CHECK(slow());
+
+    phone_passcode_write(m_draws[1]);
+    phone_run_ms(20);
+    CHECK(current_state_get() == ST_UNLOCKED && fast());
+
+    // Opcodes and operands every few seconds keep it fast well past the delay
+    for(uint32_t i = 0; i < 4; i++){
+        phone_run_ms(SLOW_DELAY_MS - 1000);
+        CHECK(fast());
+        if(i % 2 == 0){
+            CHECK(phone_write(host_app_boc()->opcode_handles.value_handle, &opcode, 1) == NRF_SUCCESS);
+        } else {
+            CHECK(phone_write(host_app_boc()->operand_handles.value_handle, operand, sizeof(operand)) == NRF_SUCCESS);
+        }
+    }
+    CHECK(current_state_get() == ST_UNLOCKED);
+    falls_back();
+
+    // A command brings it back, refused or not
+    phone_command(m_draws[1], OP_GET_MILLIS, 0, 1);
+    phone_run_ms(20);
+    CHECK(fast());
+    phone_run_ms(SLOW_DELAY_MS - 1000);
+    phone_command(0, OP_GET_MILLIS, 0, 2);
+    phone_run_ms(20);
+    CHECK((int8_t)phone_response_last()->data[1] < 0);
+    falls_back();
+
+    // The next connection starts from its own parameters and seeding is over
+    phone_disconnect();
+    phone_connect();
+    CHECK(current_state_get() == ST_CONNECTED);
+    falls_back();
+
+    printf("conn policy: ok\n");
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ *  Event queue: FIFO order across index wrap, overflow accounting, and
+ *  add_event() from the main loop preempted by interrupt producers. Ends
+ *  with the cost of one add_event()/process_event() pair.
+ */
+
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+#include "phone.h"
+#include "sdk_host.h"
+#include "ign_state_machine.h"
+#include "flight_recorder.h"
+
+#define STRESS_EVENTS 200000
+
+// Handled by evt_unsupported() in ST_UNSEEDED, so processing them has no side effects
+static const EVENT m_harmless[] = { EVT_DISCONNECTED, EVT_TIMED_OUT, EVT_PASSCODE_TIMED_OUT };
+
+static volatile uint32_t m_isr_produced;
+
+// The newest count records of a type, oldest first
+static uint32_t recorded_events(FR_TYPE type, uint8_t * p_events, uint32_t count){
+    flight_recorder_t * p_fr = FLIGHT_RECORDER;
+    uint32_t found = 0;
+    uint32_t index = p_fr->head;
+
+    for(uint32_t i = 0; i < FR_RECORDS && found < count; i++){
+        index = (index + FR_RECORDS - 1) % FR_RECORDS;
+        if(p_fr->records[index].type == type){
+            found++;
+            p_events[count - found] = p_fr->records[index].event;
+        }
+    }
+    return found;
+}
+
+static void test_order_and_overflow(void){
+    uint8_t payload[MAX_EVENT_DATA + 10];
+    uint8_t processed[MAX_EVENTS];
+
+    memset(payload, 0xA5, sizeof(payload));
+
+    // 40 rounds take the uint8_t head and tail past a wrap twice
+    for(uint32_t round = 0; round < 40; round++){
+        uint32_t dropped = events_dropped();
+
+        for(uint32_t i = 0; i < MAX_EVENTS + 2; i++){
+            EVENT event = m_harmless[(round + i) % 3];
+            // Oversized payloads are cut to MAX_EVENT_DATA
+            add_event(event, payload, (i & 1) ? sizeof(payload) : 0);
+        }
+        CHECK(events_dropped() == dropped + 2);
+
+        uint32_t count = 0;
+        while(events_queued()){
+            process_event();
+            count++;
+        }
+        CHECK(count == MAX_EVENTS);
+
+        CHECK(recorded_events(FR_PROCESSED, processed, MAX_EVENTS) == MAX_EVENTS);
+        for(uint32_t i = 0; i < MAX_EVENTS; i++){
+            CHECK(processed[i] == m_harmless[(round + i) % 3]);
+        }
+        CHECK(current_state_get() == ST_UNSEEDED);
+    }
+}
+
+static void swi1_producer(void){
+    add_event(EVT_TIMED_OUT, NULL, 0);
+    m_isr_produced++;
+}
+
+static void on_alarm(int signal){
+    (void)signal;
+    sdk_host_irq_raise(SWI1_IRQn);
+}
+
+// The main loop queues and consumes while SIGALRM, standing in for the
+// SoftDevice and timer interrupts, queues from SWI1 at any instruction.
+// Every event has to come out exactly once or be counted as dropped.
+static void test_preempted_producer(void){
+    struct itimerval interval = { { 0, 20 }, { 0, 20 } };
+    struct itimerval off = { { 0, 0 }, { 0, 0 } };
+    uint32_t main_produced = 0;
+    uint32_t processed = 0;
+    uint32_t dropped = events_dropped();
+
+    sdk_host_irq_handler_set(SWI1_IRQn, swi1_producer);
+    NVIC_EnableIRQ(SWI1_IRQn);
+    signal(SIGALRM, on_alarm);
+    setitimer(ITIMER_REAL, &interval, NULL);
+
+    while(main_produced < STRESS_EVENTS){
+        add_event(EVT_PASSCODE_TIMED_OUT, NULL, 0);
+        main_produced++;
+        if(main_produced % 3 == 0){
+            while(events_queued()){
+                process_event();
+                processed++;
+            }
+        }
+    }
+
+    setitimer(ITIMER_REAL, &off, NULL);
+    NVIC_DisableIRQ(SWI1_IRQn);
+    while(events_queued()){
+        process_event();
+        processed++;
+    }
+
+    printf("event queue: %u from the main loop, %u from SWI1, %u dropped\n",
+           main_produced, m_isr_produced, events_dropped() - dropped);
+    CHECK(m_isr_produced > 0);
+    CHECK(processed + (events_dropped() - dropped) == main_produced + m_isr_produced);
+}
+
+static double seconds(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void test_throughput(void){
+    const uint32_t events = 1000000;
+    uint8_t payload[MAX_EVENT_DATA] = { 0 };
+    double start = seconds();
+
+    for(uint32_t i = 0; i < events; i++){
+        add_event(EVT_TIMED_OUT, payload, sizeof(payload));
+        process_event();
+    }
+    printf("event queue: %.0f ns per add_event() and process_event() with a %d byte payload\n",
+           (seconds() - start) * 1e9 / events, MAX_EVENT_DATA);
+}
+
+int main(void){
+    phone_init();
+    CHECK(current_state_get() == ST_UNSEEDED);
+
+    test_order_and_overflow();
+    test_preempted_producer();
+    test_throughput();
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ *  OP_FAST_FORWARD moves the passcodes on by its operand, and refuses an
+ *  operand above FAST_FORWARD_MAX_ROTATIONS with -8 without moving them,
+ *  through the command frame and through the opcode and operand writes.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+
+#define DRAWS 3000
+
+static const uint64_t m_seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                    0x2222222222222222ULL, 0x3333333333333333ULL };
+static uint64_t m_draws[DRAWS];
+
+// Passcode of a draw, draws are numbered from 1
+static uint64_t draw(uint32_t n){
+    CHECK(n >= 1 && n <= DRAWS);
+    return m_draws[n - 1];
+}
+
+static void command_expect(uint64_t passcode, uint8_t opcode, uint32_t operand, uint8_t seq, int8_t code){
+    phone_responses_clear();
+    phone_command(passcode, opcode, operand, seq);
+    phone_run_ms(20);
+    CHECK(phone_responses() == 1);
+    CHECK(phone_response_last()->len == 2);
+    CHECK(phone_response_last()->data[0] == seq && (int8_t)phone_response_last()->data[1] == code);
+}
+
+int main(void){
+    uint8_t byte;
+    uint8_t operand[4];
+
+    phone_init();
+    phone_connect();
+    phone_seed(m_seed, m_draws, DRAWS);
+
+    command_expect(draw(2), OP_LOCK, 1, 0, 5);
+
+    // Draw 2 is current, 100 rotations on it is draw 102
+    command_expect(draw(2), OP_FAST_FORWARD, 100, 1, 5);
+    command_expect(draw(102), OP_LOCK, 0, 2, 5);
+
+    // Refused, draw 102 stays current
+    command_expect(draw(102), OP_FAST_FORWARD, 2881, 3, -8);
+    command_expect(draw(102), OP_FAST_FORWARD, 0xFFFFFFFF, 4, -8);
+    command_expect(draw(102), OP_LOCK, 1, 5, 5);
+
+    // The largest jump allowed
+    command_expect(draw(102), OP_FAST_FORWARD, 2880, 6, 5);
+    command_expect(draw(2982), OP_LOCK, 0, 7, 5);
+
+    // A refused frame streamed behind a good one: the good one is still
+    // acknowledged, ahead of the refusal, in the same notification
+    phone_responses_clear();
+    phone_command(draw(2982), OP_LOCK, 1, 8);
+    phone_command(draw(2982), OP_FAST_FORWARD, 5000, 9);
+    phone_run_ms(20);
+    CHECK(phone_responses() == 1);
+    CHECK(phone_response_last()->len == 4);
+    CHECK(phone_response_last()->data[0] == 8 && phone_response_last()->data[1] == 5);
+    CHECK(phone_response_last()->data[2] == 9 && (int8_t)phone_response_last()->data[3] == -8);
+
+    // Opcode and operand written separately
+    byte = OP_FAST_FORWARD;
+    phone_responses_clear();
+    CHECK(phone_write(host_app_boc()->opcode_handles.value_handle, &byte, 1) == NRF_SUCCESS);
+    phone_run_ms(20);
+    CHECK(phone_response_last()->data[0] == 4);
+
+    operand[0] = 0x00; operand[1] = 0x01; operand[2] = 0x00; operand[3] = 0x00;
+    phone_responses_clear();
+    CHECK(phone_write(host_app_boc()->operand_handles.value_handle, operand, sizeof(operand)) == NRF_SUCCESS);
+    phone_run_ms(20);
+    CHECK(phone_responses() == 1 && phone_response_last()->len == 1);
+    CHECK((int8_t)phone_response_last()->data[0] == -8);
+
+    command_expect(draw(2982), OP_LOCK, 1, 10, 5);
+
+    printf("fast forward: ok\n");
+    return 0;
+}
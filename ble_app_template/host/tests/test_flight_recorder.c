@@ -0,0 +1,65 @@
+/*
+ *  Reads the flight recorder characteristic with a long read while the
+ *  state machine keeps adding records, and checks the read sees the
+ *  recorder as it was when the read started.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "phone.h"
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "host_app.h"
+#include "flight_recorder.h"
+
+#define READ_SIZE (SDK_HOST_ATT_MAX_WRITE + 2)  // An ATT read response is one byte longer than a write
+
+// Reads the whole characteristic the way a phone does a long read, calling
+// between() after the first part
+static void long_read(flight_recorder_t * p_out, void (*between)(void)){
+    uint8_t * p_bytes = (uint8_t *)p_out;
+    uint16_t handle = host_app_boc()->fr_handles.value_handle;
+    uint16_t offset = 0;
+    uint16_t len;
+
+    do {
+        len = sdk_host_ble_read(handle, offset, &p_bytes[offset], READ_SIZE);
+        if(offset == 0 && between){
+            between();
+        }
+        offset += len;
+    } while(len == READ_SIZE && offset < sizeof(flight_recorder_t));
+    CHECK(offset == sizeof(flight_recorder_t));
+}
+
+static void wrong_passcodes(void){
+    for(int i = 0; i < 4; i++){
+        phone_passcode_write(0x5A5A5A5A5A5A5A5AULL + i);
+        phone_run_ms(20);
+    }
+}
+
+int main(void){
+    flight_recorder_t before;
+    flight_recorder_t after;
+    static const fr_record_t unused;
+
+    phone_init();
+    phone_connect();
+
+    long_read(&before, wrong_passcodes);
+    CHECK(before.magic == FR_MAGIC && !before.wrapped);
+    // Records added during the read are not in it
+    for(uint32_t i = before.head; i < FR_RECORDS; i++){
+        CHECK(memcmp(&before.records[i], &unused, sizeof(unused)) == 0);
+    }
+
+    // The next read starts over at offset 0 and sees them
+    long_read(&after, NULL);
+    CHECK(after.magic == FR_MAGIC);
+    CHECK(memcmp(&after, FLIGHT_RECORDER, sizeof(flight_recorder_t)) == 0);
+    CHECK(after.head == (before.head + 8) % FR_RECORDS);
+
+    printf("flight recorder: %u records in a %u byte long read\n", after.head, (unsigned)sizeof(after));
+    return 0;
+}
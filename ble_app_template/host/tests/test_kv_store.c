@@ -0,0 +1,108 @@
+/*
+ *  Fills the key/value store until it compacts onto its other page, with
+ *  the compaction's store failing after pstorage took it and then refused
+ *  outright, and checks the newest value written is in flash throughout,
+ *  so a reset at any point would find it.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "pstorage.h"
+#include "kv_store.h"
+
+#define KV_PAGES 2                              // kv_store.c's pages, the first ones registered
+#define RECORD_SIZE 12                          // Header and a 4 byte value
+#define RECORDS_PER_PAGE (PSTORAGE_FLASH_PAGE_SIZE / RECORD_SIZE)
+
+static uint32_t m_value;
+
+// The value of the newest record of the key in either page, 0 if there is none
+static uint32_t flash_value(KV_KEY key){
+    const uint8_t * p_flash = sdk_host_flash();
+    uint32_t newest = 0;
+    uint32_t value = 0;
+
+    for(uint32_t page = 0; page < KV_PAGES; page++){
+        const uint8_t * p_page = &p_flash[page * PSTORAGE_FLASH_PAGE_SIZE];
+        uint32_t offset = 0;
+
+        while(offset + 8 <= PSTORAGE_FLASH_PAGE_SIZE && p_page[offset] != 0xFF){
+            uint8_t len = p_page[offset + 1];
+            uint32_t sequence;
+
+            memcpy(&sequence, &p_page[offset + 4], sizeof(sequence));
+            if(p_page[offset] == key && len == sizeof(value) && sequence > newest){
+                newest = sequence;
+                memcpy(&value, &p_page[offset + 8], sizeof(value));
+            }
+            offset += 8 + (len + 3) / 4 * 4;
+        }
+    }
+    return value;
+}
+
+static bool page_erased(uint32_t page){
+    const uint8_t * p_page = &sdk_host_flash()[page * PSTORAGE_FLASH_PAGE_SIZE];
+
+    for(uint32_t i = 0; i < PSTORAGE_FLASH_PAGE_SIZE; i++){
+        if(p_page[i] != 0xFF){
+            return false;
+        }
+    }
+    return true;
+}
+
+static void put(void){
+    m_value++;
+    CHECK(kv_store_put(KV_KEY_SEED_POSITION, &m_value, sizeof(m_value)) == NRF_SUCCESS);
+    phone_run_ms(100);
+}
+
+static void value_check(uint32_t in_flash){
+    uint32_t value = 0;
+
+    CHECK(kv_store_get(KV_KEY_SEED_POSITION, &value, sizeof(value)) == sizeof(value));
+    CHECK(value == m_value);
+    CHECK(flash_value(KV_KEY_SEED_POSITION) == in_flash);
+}
+
+int main(void){
+    phone_init();
+
+    for(uint32_t i = 0; i < RECORDS_PER_PAGE; i++){
+        put();
+    }
+    value_check(m_value);
+    CHECK(page_erased(1));
+
+    // The spare page is erased, then the copy onto it fails. The full page
+    // has to stay as it is.
+    sdk_host_flash_fail(1, 1);
+    put();
+    value_check(m_value - 1);
+    CHECK(!page_erased(0));
+
+    // Retried with the next put, the full page goes once the copy is in
+    put();
+    value_check(m_value);
+    CHECK(page_erased(0) && !page_erased(1));
+
+    for(uint32_t i = 1; i < RECORDS_PER_PAGE; i++){
+        put();
+    }
+    value_check(m_value);
+
+    // pstorage refuses the copy back onto the first page
+    sdk_host_flash_refuse(0, 1);
+    put();
+    value_check(m_value - 1);
+    CHECK(page_erased(0) && !page_erased(1));
+
+    put();
+    value_check(m_value);
+    CHECK(!page_erased(0) && page_erased(1));
+
+    printf("kv store: %u puts over two compactions\n", m_value);
+    return 0;
+}
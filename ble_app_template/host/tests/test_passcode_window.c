@@ -0,0 +1,93 @@
+/*
+ *  Built with a window of 6 passcodes, two behind and three ahead of the
+ *  current one. Every passcode in the window is accepted and answered with
+ *  its offset, written on its own and in command frames, where the offset
+ *  goes ahead of the ack in the same notification. Passcodes outside the
+ *  window are refused.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+
+#define DRAWS 16
+#define CURRENT 4                               // Draw current after the fast forward
+
+#if PASSCODE_LOOKBEHIND != 2 || PASSCODE_LOOKAHEAD != 3
+#error "Built for a window of two passcodes behind and three ahead"
+#endif
+
+static const uint64_t m_seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                    0x2222222222222222ULL, 0x3333333333333333ULL };
+static uint64_t m_draws[DRAWS];
+
+// Passcode of a draw, draws are numbered from 1
+static uint64_t draw(uint32_t n){
+    CHECK(n >= 1 && n <= DRAWS);
+    return m_draws[n - 1];
+}
+
+static void response_expect(const int8_t * p_expected, uint8_t len){
+    CHECK(phone_responses() == 1);
+    CHECK(phone_response_last()->len == len);
+    CHECK(memcmp(phone_response_last()->data, p_expected, len) == 0);
+}
+
+// On a link of its own, a correct passcode unlocks and the next is refused
+static void passcode_expect(int32_t offset, const int8_t * p_expected, uint8_t len){
+    phone_connect();
+    phone_responses_clear();
+    phone_passcode_write(draw(CURRENT + offset));
+    phone_run_ms(20);
+    response_expect(p_expected, len);
+    phone_disconnect();
+}
+
+static void command_expect(int32_t offset, uint8_t seq, const int8_t * p_expected, uint8_t len){
+    phone_responses_clear();
+    phone_command(draw(CURRENT + offset), OP_LOCK, 1, seq);
+    phone_run_ms(20);
+    response_expect(p_expected, len);
+}
+
+int main(void){
+    phone_init();
+    phone_connect();
+    phone_seed(m_seed, m_draws, DRAWS);
+
+    // Draw 2 is current, two rotations on
+    phone_responses_clear();
+    phone_command(draw(2), OP_FAST_FORWARD, CURRENT - 2, 0);
+    phone_run_ms(20);
+    response_expect((const int8_t[]){ 0, 5 }, 2);
+    phone_disconnect();
+
+    passcode_expect(-2, (const int8_t[]){ 8, -2 }, 2);
+    passcode_expect(-1, (const int8_t[]){ 6 }, 1);
+    passcode_expect(0, (const int8_t[]){ 3 }, 1);
+    passcode_expect(1, (const int8_t[]){ 7 }, 1);
+    passcode_expect(2, (const int8_t[]){ 8, 2 }, 2);
+    passcode_expect(3, (const int8_t[]){ 8, 3 }, 2);
+
+    phone_connect();
+    command_expect(-2, 1, (const int8_t[]){ 1, 8, -2, 1, 5 }, 5);
+    command_expect(-1, 2, (const int8_t[]){ 2, 6, 2, 5 }, 4);
+    command_expect(0, 3, (const int8_t[]){ 3, 5 }, 2);
+    command_expect(1, 4, (const int8_t[]){ 4, 7, 4, 5 }, 4);
+    command_expect(3, 5, (const int8_t[]){ 5, 8, 3, 5, 5 }, 5);
+
+    // Just outside the window on either side
+    command_expect(-3, 6, (const int8_t[]){ 6, -3 }, 2);
+    command_expect(4, 7, (const int8_t[]){ 7, -3 }, 2);
+
+    // Streamed: the ack of the first frame goes out before the offset of the second
+    phone_responses_clear();
+    phone_command(draw(CURRENT), OP_LOCK, 1, 8);
+    phone_command(draw(CURRENT + 2), OP_LOCK, 0, 9);
+    phone_run_ms(20);
+    response_expect((const int8_t[]){ 8, 5, 9, 8, 2, 9, 5 }, 7);
+
+    printf("passcode window: ok\n");
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ *  OP_POWER_STATS answers with the profile of one state, logs them all for
+ *  POWER_STATS_DUMP and refuses any other operand with -8. Built without
+ *  POWER_PROFILING it answers -1 whatever the operand.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+#include "power_profile.h"
+
+static const uint64_t m_seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                    0x2222222222222222ULL, 0x3333333333333333ULL };
+
+#ifdef POWER_PROFILING
+static uint32_t get_be32(const uint8_t * p_in){
+    return ((uint32_t)p_in[0] << 24) | ((uint32_t)p_in[1] << 16) | ((uint32_t)p_in[2] << 8) | p_in[3];
+}
+
+// The wake reason counts of a state. The command carries the passcode
+// current by now, one rotation every 30 s from the seeding.
+static void reasons_get(const uint64_t * p_draws, STATE state, uint8_t seq, uint16_t * p_reasons){
+    const phone_response_t * p_stats;
+
+    phone_responses_clear();
+    phone_command(p_draws[1 + sdk_host_now() / SDK_HOST_MS(30000)], OP_POWER_STATS, state, seq);
+    phone_run_ms(20);
+    CHECK(phone_responses() == 2);
+    p_stats = phone_response(1);
+    CHECK(p_stats->len == 20);
+    for(int reason = 0; reason < NUM_POWER_WAKES; reason++){
+        p_reasons[reason] = (p_stats->data[12 + 2 * reason] << 8) | p_stats->data[13 + 2 * reason];
+    }
+}
+
+// One timer wakeup between the two. The test's own runs end in wakeups of
+// no particular reason, so the other counts move anyway.
+static void timer_wake_check(const uint16_t * p_before, const uint16_t * p_after){
+    CHECK(p_after[POWER_WAKE_TIMER] == p_before[POWER_WAKE_TIMER] + 1);
+}
+#endif
+
+static void command_expect(uint64_t passcode, uint32_t operand, uint8_t seq, int8_t code, uint32_t responses){
+    phone_responses_clear();
+    phone_command(passcode, OP_POWER_STATS, operand, seq);
+    phone_run_ms(20);
+    CHECK(phone_responses() == responses);
+    CHECK(phone_response(0)->len == 2);
+    CHECK(phone_response(0)->data[0] == seq && (int8_t)phone_response(0)->data[1] == code);
+}
+
+int main(void){
+    uint64_t draws[8];
+
+    phone_init();
+    phone_connect();
+    phone_seed(m_seed, draws, 8);
+    phone_run_ms(1000);
+
+#ifdef POWER_PROFILING
+    const phone_response_t * p_stats;
+
+    command_expect(draws[1], ST_CONNECTED, 0, 5, 2);
+    p_stats = phone_response(1);
+    CHECK(p_stats->len == 20);
+    CHECK(get_be32(&p_stats->data[0]) + get_be32(&p_stats->data[4]) >= 1000);
+    CHECK(get_be32(&p_stats->data[8]) > 0);
+
+    command_expect(draws[1], NUM_STATES, 1, -8, 1);
+    command_expect(draws[1], 0xFFFFFFFF, 2, 5, 1);
+
+    // Unlocked, the fall back to the slow connection profile 5 s after the
+    // last command wakes the CPU
+    uint16_t before[NUM_POWER_WAKES];
+    uint16_t after[NUM_POWER_WAKES];
+
+    reasons_get(draws, ST_UNLOCKED, 3, before);
+    phone_run_ms(6000);
+    reasons_get(draws, ST_UNLOCKED, 4, after);
+    timer_wake_check(before, after);
+
+    // Unlocked at 100 s and relocked by the rotation at 120 s, then the
+    // timebase refresh at 128 s wakes it
+    phone_run_ms(100000 - sdk_host_now() * 1000 / SDK_HOST_TICKS_PER_SECOND);
+    reasons_get(draws, ST_LOCKED, 5, before);
+    phone_run_ms(40000);
+    reasons_get(draws, ST_LOCKED, 6, after);
+    timer_wake_check(before, after);
+#else
+    command_expect(draws[1], ST_CONNECTED, 0, -1, 1);
+#endif
+
+    printf("power stats: ok\n");
+    return 0;
+}
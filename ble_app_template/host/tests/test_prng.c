@@ -0,0 +1,135 @@
+/*
+ *  Passcode generator interface, built once per PRNG_BACKEND. prng_next64()
+ *  has to give the stream of the reference generator the phone runs, the
+ *  same key has to give the same passcodes after a reseed and prng_jump()
+ *  has to match stepping.
+ */
+
+#include "phone.h"
+#include "prng.h"
+#if PRNG_BACKEND == PRNG_TINYMT64
+#include "tinymt64.h"
+#else
+#include "mt19937-64.h"
+#endif
+
+#define OUTPUTS 10000
+
+static const uint64_t m_key[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                   0x2222222222222222ULL, 0x3333333333333333ULL };
+
+static void seed(const uint64_t key[4]){
+    uint64_t copy[4];
+    memcpy(copy, key, sizeof(copy));
+    prng_seed(copy, 4);
+}
+
+#if PRNG_BACKEND == PRNG_TINYMT64
+
+static void reference_init(tinymt64_t * p_tinymt){
+    memset(p_tinymt, 0, sizeof(*p_tinymt));
+    p_tinymt->mat1 = 0xfa051f40;
+    p_tinymt->mat2 = 0xffd0fff4;
+    p_tinymt->tmat = 0x58d02ffeffbfffbcULL;
+}
+
+static void test_reference(void){
+    static const uint64_t seed_one[3] = { 15503804787016557143ULL, 17280942441431881838ULL,
+                                          2177846447079362065ULL };
+    tinymt64_t tinymt;
+
+    // First outputs of the reference tinymt64 check program for seed 1
+    reference_init(&tinymt);
+    tinymt64_init(&tinymt, 1);
+    for(int i = 0; i < 3; i++){
+        CHECK(tinymt64_generate_uint64(&tinymt) == seed_one[i]);
+    }
+
+    reference_init(&tinymt);
+    tinymt64_init_by_array(&tinymt, m_key, 4);
+    seed(m_key);
+    for(int i = 0; i < OUTPUTS; i++){
+        CHECK(prng_next64() == tinymt64_generate_uint64(&tinymt));
+    }
+}
+
+#else
+
+static void test_reference(void){
+    uint64_t copy[4];
+    uint64_t expected[OUTPUTS];
+
+    memcpy(copy, m_key, sizeof(copy));
+    init_by_array64(copy, 4);
+    for(int i = 0; i < OUTPUTS; i++){
+        expected[i] = genrand64_int64();
+    }
+
+    seed(m_key);
+    for(int i = 0; i < OUTPUTS; i++){
+        CHECK(prng_next64() == expected[i]);
+    }
+}
+
+#endif
+
+static void test_reseed(void){
+    static const uint64_t other[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                       0x2222222222222222ULL, 0x3333333333333334ULL };
+    uint64_t first[16];
+    uint32_t differ = 0;
+
+    seed(m_key);
+    for(int i = 0; i < 16; i++){
+        first[i] = prng_next64();
+    }
+    for(int i = 0; i < 100; i++){
+        prng_next64();
+    }
+
+    seed(m_key);
+    for(int i = 0; i < 16; i++){
+        CHECK(prng_next64() == first[i]);
+    }
+
+    // One bit of the last word changes every passcode
+    seed(other);
+    for(int i = 0; i < 16; i++){
+        differ += prng_next64() != first[i];
+    }
+    CHECK(differ == 16);
+}
+
+// prng_jump(n) has to land where n calls of prng_next64() do, across the
+// MT19937-64 regeneration boundaries and for long TinyMT64 jumps
+static void test_jump(void){
+    static const uint64_t steps[] = { 0, 1, 2, 199, 200, 201, 399, 1000, 2880, 12345, 100000 };
+
+    for(uint32_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++){
+        uint64_t stepped[4];
+
+        seed(m_key);
+        prng_next64();                          // Start off a regeneration boundary too
+        for(uint64_t n = 0; n < steps[i]; n++){
+            prng_next64();
+        }
+        for(int k = 0; k < 4; k++){
+            stepped[k] = prng_next64();
+        }
+
+        seed(m_key);
+        prng_next64();
+        prng_jump(steps[i]);
+        for(int k = 0; k < 4; k++){
+            CHECK(prng_next64() == stepped[k]);
+        }
+    }
+}
+
+int main(void){
+    test_reference();
+    test_reseed();
+    test_jump();
+    printf("prng backend %d: ok\n", PRNG_BACKEND);
+    return 0;
+}
@@ -0,0 +1,51 @@
+/*
+ *  Seeds the device, unlocks it, runs a command and keeps it powered for a
+ *  while, checking the outputs and the answers the phone sees.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+#include "custom_board.h"
+
+int main(void){
+    static const uint64_t seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                      0x2222222222222222ULL, 0x3333333333333333ULL };
+    uint64_t draws[4];
+
+    phone_init();
+    CHECK(current_state_get() == ST_UNSEEDED);
+
+    phone_connect();
+    CHECK(current_state_get() == ST_UNSEEDED_CONNECTED);
+
+    phone_seed(seed, draws, 4);
+    CHECK(current_state_get() == ST_CONNECTED);
+
+    // Draw 2 is the current passcode
+    phone_passcode_write(draws[1]);
+    phone_run_ms(20);
+    CHECK(phone_responses() == 1 && phone_response_last()->data[0] == 3);
+    CHECK(current_state_get() == ST_UNLOCKED);
+
+    phone_responses_clear();
+    phone_command(draws[1], OP_IGNITION, 1, 0);
+    phone_run_ms(20);
+    CHECK(phone_responses() == 1);
+    CHECK(phone_response_last()->data[0] == 0 && phone_response_last()->data[1] == 5);
+    CHECK(sdk_host_gpio_out() & (1UL << LED_2));
+
+    // The rotation relocks the controller, the link stays up
+    phone_run_ms(31000);
+    CHECK(current_state_get() == ST_LOCKED);
+
+    phone_disconnect();
+    CHECK(current_state_get() == ST_IDLE);
+
+    phone_run_ms(10 * 60 * 1000);
+    CHECK(current_state_get() == ST_IDLE);
+
+    printf("smoke: ok\n");
+    return 0;
+}
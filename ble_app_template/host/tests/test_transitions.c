@@ -0,0 +1,280 @@
+/*
+ *  Every (STATE, EVENT) pair of the transition table. Each pair runs in a
+ *  forked child that boots the firmware, walks the phone into the state
+ *  the way the app would, queues the event with a well formed payload and
+ *  checks the state the machine lands in, the response the phone sees and
+ *  whether the seed position was written to flash. LOCKED and UNLOCKED are
+ *  entered a rotation after seeding, with that rotation not yet saved.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "phone.h"
+#include "sdk_host.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+#include "kv_store.h"
+
+#define NO_RESPONSE 127
+#define COMMAND_SEQ 7
+#define POSITION_MAX 16                         // Larger than the position record
+
+typedef struct {
+    bool listed;
+    STATE next_state;
+    int8_t response;                            // Last byte of the first notification, NO_RESPONSE if none
+    bool saves;                                 // A new seed position is in flash afterwards
+} expected_t;
+
+#define T(next, response) { true, next, response, false }
+#define T_SAVES(next, response) { true, next, response, true }
+
+static const expected_t m_expected[NUM_STATES][NUM_EVENTS] = {
+    [ST_INVALID] = {
+        [EVT_INVALID]            = T(ST_INVALID,            NO_RESPONSE),
+        [EVT_BUTTON_PRESS]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_PASSCODE_SET]       = T(ST_INVALID,            NO_RESPONSE),
+        [EVT_CONNECTED]          = T(ST_INVALID,            NO_RESPONSE),
+        [EVT_DISCONNECTED]       = T(ST_INVALID,            NO_RESPONSE),
+        [EVT_TIMED_OUT]          = T(ST_INVALID,            NO_RESPONSE),
+        [EVT_PASSCODE_TIMED_OUT] = T(ST_INVALID,            NO_RESPONSE),
+        [EVT_OPERATION_SET]      = T(ST_INVALID,            NO_RESPONSE),
+        [EVT_OPERAND_SET]        = T(ST_INVALID,            NO_RESPONSE),
+        [EVT_COMMAND_SET]        = T(ST_INVALID,            NO_RESPONSE),
+    },
+    [ST_UNSEEDED] = {
+        [EVT_INVALID]            = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_BUTTON_PRESS]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_PASSCODE_SET]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_CONNECTED]          = T(ST_UNSEEDED_CONNECTED, NO_RESPONSE),
+        [EVT_DISCONNECTED]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_TIMED_OUT]          = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_PASSCODE_TIMED_OUT] = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_OPERATION_SET]      = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_OPERAND_SET]        = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_COMMAND_SET]        = T(ST_UNSEEDED,           NO_RESPONSE),
+    },
+    [ST_UNSEEDED_CONNECTED] = {
+        [EVT_INVALID]            = T(ST_UNSEEDED_CONNECTED, -1),
+        [EVT_BUTTON_PRESS]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_PASSCODE_SET]       = T(ST_UNSEEDED_CONNECTED, 1),     // First of the four seed words
+        [EVT_CONNECTED]          = T(ST_UNSEEDED_CONNECTED, NO_RESPONSE),
+        [EVT_DISCONNECTED]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_TIMED_OUT]          = T(ST_UNSEEDED_CONNECTED, NO_RESPONSE),
+        [EVT_PASSCODE_TIMED_OUT] = T(ST_UNSEEDED_CONNECTED, NO_RESPONSE),
+        [EVT_OPERATION_SET]      = T(ST_UNSEEDED_CONNECTED, -5),
+        [EVT_OPERAND_SET]        = T(ST_UNSEEDED_CONNECTED, -6),
+        [EVT_COMMAND_SET]        = T(ST_UNSEEDED_CONNECTED, -5),
+    },
+    [ST_IDLE] = {
+        [EVT_INVALID]            = T(ST_IDLE,               NO_RESPONSE),
+        [EVT_BUTTON_PRESS]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_PASSCODE_SET]       = T(ST_IDLE,               NO_RESPONSE),
+        [EVT_CONNECTED]          = T(ST_CONNECTED,          NO_RESPONSE),
+        [EVT_DISCONNECTED]       = T(ST_IDLE,               NO_RESPONSE),
+        [EVT_TIMED_OUT]          = T(ST_IDLE,               NO_RESPONSE),
+        [EVT_PASSCODE_TIMED_OUT] = T(ST_IDLE,               NO_RESPONSE),
+        [EVT_OPERATION_SET]      = T(ST_IDLE,               NO_RESPONSE),
+        [EVT_OPERAND_SET]        = T(ST_IDLE,               NO_RESPONSE),
+        [EVT_COMMAND_SET]        = T(ST_IDLE,               NO_RESPONSE),
+    },
+    [ST_CONNECTED] = {
+        [EVT_INVALID]            = T(ST_CONNECTED,          -1),
+        [EVT_BUTTON_PRESS]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_PASSCODE_SET]       = T(ST_UNLOCKED,           3),
+        [EVT_CONNECTED]          = T(ST_CONNECTED,          NO_RESPONSE),
+        [EVT_DISCONNECTED]       = T(ST_IDLE,               NO_RESPONSE),
+        [EVT_TIMED_OUT]          = T(ST_CONNECTED,          NO_RESPONSE),
+        [EVT_PASSCODE_TIMED_OUT] = T(ST_CONNECTED,          NO_RESPONSE),
+        [EVT_OPERATION_SET]      = T(ST_CONNECTED,          -5),
+        [EVT_OPERAND_SET]        = T(ST_CONNECTED,          -6),
+        [EVT_COMMAND_SET]        = T(ST_UNLOCKED,           5),
+    },
+    [ST_LOCKED] = {
+        [EVT_INVALID]            = T(ST_LOCKED,             -1),
+        [EVT_BUTTON_PRESS]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_PASSCODE_SET]       = T(ST_UNLOCKED,           3),
+        [EVT_CONNECTED]          = T(ST_LOCKED,             NO_RESPONSE),
+        [EVT_DISCONNECTED]       = T_SAVES(ST_IDLE,         NO_RESPONSE),    // The rotation since seeding
+        [EVT_TIMED_OUT]          = T(ST_LOCKED,             NO_RESPONSE),
+        [EVT_PASSCODE_TIMED_OUT] = T(ST_LOCKED,             NO_RESPONSE),
+        [EVT_OPERATION_SET]      = T(ST_LOCKED,             -5),
+        [EVT_OPERAND_SET]        = T(ST_LOCKED,             -6),
+        [EVT_COMMAND_SET]        = T(ST_UNLOCKED,           5),
+    },
+    [ST_UNLOCKED] = {
+        [EVT_INVALID]            = T(ST_UNLOCKED,           -1),
+        [EVT_BUTTON_PRESS]       = T(ST_UNSEEDED,           NO_RESPONSE),
+        [EVT_PASSCODE_SET]       = T(ST_UNLOCKED,           -1),
+        [EVT_CONNECTED]          = T(ST_UNLOCKED,           NO_RESPONSE),
+        [EVT_DISCONNECTED]       = T_SAVES(ST_IDLE,         NO_RESPONSE),    // The rotation since seeding
+        [EVT_TIMED_OUT]          = T(ST_UNLOCKED,           NO_RESPONSE),
+        [EVT_PASSCODE_TIMED_OUT] = T(ST_LOCKED,             NO_RESPONSE),
+        [EVT_OPERATION_SET]      = T(ST_UNLOCKED,           4),
+        [EVT_OPERAND_SET]        = T(ST_UNLOCKED,           -4),    // No operation selected yet
+        [EVT_COMMAND_SET]        = T(ST_UNLOCKED,           5),
+    },
+};
+
+extern uint8_t current_state;
+
+static const uint64_t m_seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                    0x2222222222222222ULL, 0x3333333333333333ULL };
+
+static void put_be64(uint8_t * p_out, uint64_t value){
+    for(int i = 0; i < 8; i++){
+        p_out[i] = value >> ((7 - i) * 8);
+    }
+}
+
+// Walks into the state and returns the passcode it currently accepts
+static uint64_t state_enter(STATE state){
+    uint64_t draws[4];
+
+    phone_init();
+    switch(state){
+        case ST_INVALID:
+            current_state = ST_INVALID;         // Only reachable through memory corruption
+            return 0;
+        case ST_UNSEEDED:
+            return 0;
+        case ST_UNSEEDED_CONNECTED:
+            phone_connect();
+            return 0;
+        default:
+            break;
+    }
+
+    phone_connect();
+    phone_seed(m_seed, draws, 4);
+    CHECK(current_state_get() == ST_CONNECTED);
+    if(state == ST_CONNECTED){
+        return draws[1];
+    }
+    if(state == ST_IDLE){
+        phone_disconnect();
+        return draws[1];
+    }
+
+    phone_passcode_write(draws[1]);
+    phone_run_ms(20);
+    CHECK(current_state_get() == ST_UNLOCKED);
+    phone_run_ms(30000);
+    CHECK(current_state_get() == ST_LOCKED);
+    if(state == ST_LOCKED){
+        return draws[2];
+    }
+
+    phone_passcode_write(draws[2]);
+    phone_run_ms(20);
+    CHECK(current_state_get() == ST_UNLOCKED);
+    return draws[2];
+}
+
+// Length of the position record in flash, 0 if there is none
+static uint8_t position_get(uint8_t * p_position){
+    memset(p_position, 0, POSITION_MAX);
+    return kv_store_get(KV_KEY_SEED_POSITION, p_position, POSITION_MAX);
+}
+
+static void event_queue(EVENT event, STATE state, uint64_t passcode){
+    uint8_t data[MAX_EVENT_DATA] = { 0 };
+    uint8_t size = 0;
+
+    switch(event){
+        case EVT_PASSCODE_SET:
+            put_be64(data, (state == ST_UNSEEDED_CONNECTED) ? m_seed[0] : passcode);
+            size = 8;
+            break;
+        case EVT_OPERATION_SET:
+            data[0] = OP_LOCK;
+            size = 1;
+            break;
+        case EVT_OPERAND_SET:
+            data[0] = 1;
+            size = 1;
+            break;
+        case EVT_COMMAND_SET:
+            put_be64(&data[CMD_PASSCODE_OFFSET], passcode);
+            data[CMD_OPCODE_OFFSET] = OP_LOCK;
+            data[CMD_OPERAND_OFFSET + 3] = 1;
+            data[CMD_SEQ_OFFSET] = COMMAND_SEQ;
+            size = CMD_FRAME_LEN;
+            break;
+        default:
+            break;
+    }
+    add_event(event, data, size);
+}
+
+static int pair_run(STATE state, EVENT event){
+    const expected_t * p_expected = &m_expected[state][event];
+    uint64_t passcode = state_enter(state);
+    uint8_t position[POSITION_MAX];
+    uint8_t position_before[POSITION_MAX];
+    uint8_t len_before;
+    uint8_t len;
+
+    phone_run_ms(20);
+    CHECK(!events_queued());
+    CHECK(current_state_get() == state);
+    len_before = position_get(position_before);
+
+    phone_responses_clear();
+    event_queue(event, state, passcode);
+    process_event();
+    if(current_state_get() != p_expected->next_state){
+        fprintf(stderr, "state %d event %d: went to %d, expected %d\n",
+                state, event, current_state_get(), p_expected->next_state);
+        return 1;
+    }
+
+    // Notifications go out from the SoftDevice's TX buffers
+    phone_run_ms(20);
+    int8_t response = NO_RESPONSE;
+    if(phone_responses()){
+        const phone_response_t * p_response = phone_response(0);
+        response = (int8_t)p_response->data[p_response->len - 1];
+    }
+    if(response != p_expected->response){
+        fprintf(stderr, "state %d event %d: answered %d, expected %d\n",
+                state, event, response, p_expected->response);
+        return 1;
+    }
+
+    // Written by now, the flash operations took the same 20 ms
+    len = position_get(position);
+    bool saved = len != 0 && (len != len_before || memcmp(position, position_before, len) != 0);
+    if(saved != p_expected->saves){
+        fprintf(stderr, "state %d event %d: %s the position, expected %s\n", state, event,
+                saved ? "saved" : "did not save", p_expected->saves ? "to save it" : "not to");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void){
+    uint32_t failed = 0;
+
+    for(int state = 0; state < NUM_STATES; state++){
+        for(int event = 0; event < NUM_EVENTS; event++){
+            int status;
+
+            CHECK(m_expected[state][event].listed);
+            fflush(stdout);
+            pid_t pid = fork();
+            CHECK(pid >= 0);
+            if(pid == 0){
+                _exit(pair_run((STATE)state, (EVENT)event));
+            }
+            CHECK(waitpid(pid, &status, 0) == pid);
+            if(!WIFEXITED(status) || WEXITSTATUS(status) != 0){
+                failed++;
+            }
+        }
+    }
+
+    printf("transitions: %d pairs, %u failed\n", NUM_STATES * NUM_EVENTS, failed);
+    return failed != 0;
+}
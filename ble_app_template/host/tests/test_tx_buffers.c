@@ -0,0 +1,74 @@
+/*
+ *  More responses than the SoftDevice has TX buffers for: the ones it
+ *  refuses with BLE_ERROR_NO_TX_BUFFERS wait in the BOC queue and go out on
+ *  the following BLE_EVT_TX_COMPLETEs, in order and none dropped. The -2
+ *  and -3 of a last wrong passcode go out as one notification.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "host_app.h"
+#include "ign_state_machine.h"
+
+#define DRAWS 4
+#define COMMANDS (SDK_HOST_TX_BUFFERS + BLE_BOC_TX_QUEUE_SIZE)  // Every buffer and every queue slot
+
+#if COMMANDS > MAX_EVENTS
+#error "The commands must all fit in the event queue"
+#endif
+
+static const uint64_t m_seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                    0x2222222222222222ULL, 0x3333333333333333ULL };
+static uint64_t m_draws[DRAWS];
+
+static void response_expect(uint32_t index, const int8_t * p_expected, uint8_t len){
+    CHECK(index < phone_responses());
+    CHECK(phone_response(index)->len == len);
+    CHECK(memcmp(phone_response(index)->data, p_expected, len) == 0);
+}
+
+int main(void){
+    phone_init();
+    phone_connect();
+    phone_seed(m_seed, m_draws, DRAWS);
+    phone_passcode_write(m_draws[1]);
+    phone_run_ms(20);
+    CHECK(current_state_get() == ST_UNLOCKED);
+
+    // Each frame is answered {seq, -4} in a notification of its own, all in
+    // the one pass of the main loop
+    phone_responses_clear();
+    for(uint32_t seq = 1; seq <= COMMANDS; seq++){
+        phone_command(m_draws[1], OP_INVALID, 0, seq);
+    }
+    phone_run_ms(1);
+    CHECK(phone_responses() == SDK_HOST_TX_BUFFERS);
+
+    phone_run_ms(50);
+    CHECK(phone_responses() == COMMANDS);
+    for(uint32_t seq = 1; seq <= COMMANDS; seq++){
+        response_expect(seq - 1, (const int8_t[]){ seq, -4 }, 2);
+    }
+    CHECK(host_app_boc()->tx_dropped == 0);
+
+    // Five wrong passcodes at once, the last drops the link
+    phone_disconnect();
+    phone_connect();
+    CHECK(current_state_get() == ST_CONNECTED);
+    phone_responses_clear();
+    for(uint32_t i = 0; i < 5; i++){
+        phone_passcode_write(0);
+    }
+    phone_run_ms(50);
+    CHECK(phone_responses() == 5);
+    for(uint32_t i = 0; i < 4; i++){
+        response_expect(i, (const int8_t[]){ -3 }, 1);
+    }
+    response_expect(4, (const int8_t[]){ -2, -3 }, 2);
+    CHECK(!sdk_host_ble_connected() && current_state_get() == ST_IDLE);
+    CHECK(host_app_boc()->tx_dropped == 0);
+
+    printf("tx buffers: ok\n");
+    return 0;
+}
@@ -0,0 +1,271 @@
+/*
+ *  Drives the UART command channel from the far end of the emulated UART0
+ *  line: a session refused while a phone holds the link, phones turned away
+ *  while one is open, seeding and a command over SLIP frames, each event
+ *  answered with one RESPONSE frame, and frames with a bad CRC, a bad escape
+ *  or too many bytes dropped without an answer.
+ */
+
+#include "phone.h"
+#include "sdk_host.h"
+#include "sdk_host_ble.h"
+#include "ign_state_machine.h"
+#include "crc16_ccitt.h"
+#include "uart_cmd.h"
+#include "prng.h"
+
+#define SLIP_END     0xC0
+#define SLIP_ESC     0xDB
+#define SLIP_ESC_END 0xDC
+#define SLIP_ESC_ESC 0xDD
+
+#define FRAMES 8
+#define FRAME_MAX 48
+
+typedef struct {
+    uint8_t data[FRAME_MAX];                    // Type and payload, the CRC checked and stripped
+    uint8_t len;
+} frame_t;
+
+static frame_t m_frames[FRAMES];
+static uint32_t m_frame_count;
+static uint8_t m_rx[FRAME_MAX + 2];
+static uint32_t m_rx_len;
+static bool m_rx_escaped;
+
+static uint32_t slip_put(uint8_t * p_out, const uint8_t * p_data, uint32_t len){
+    uint32_t out = 0;
+
+    for(uint32_t i = 0; i < len; i++){
+        if(p_data[i] == SLIP_END){
+            p_out[out++] = SLIP_ESC;
+            p_out[out++] = SLIP_ESC_END;
+        } else if(p_data[i] == SLIP_ESC){
+            p_out[out++] = SLIP_ESC;
+            p_out[out++] = SLIP_ESC_ESC;
+        } else {
+            p_out[out++] = p_data[i];
+        }
+    }
+    return out;
+}
+
+// Sends type and payload as one frame, with crc_xor flipping bits of the CRC
+static void frame_send_crc(uint8_t type, const void * p_payload, uint32_t len, uint16_t crc_xor){
+    uint8_t frame[1 + 64 + 2];
+    uint8_t line[2 * sizeof(frame) + 2];
+    uint32_t out = 0;
+    uint16_t crc;
+
+    CHECK(len <= 64);
+    frame[0] = type;
+    memcpy(&frame[1], p_payload, len);
+    crc = crc16_update(CRC16_CCITT_INIT, frame, 1 + len) ^ crc_xor;
+    frame[1 + len] = crc >> 8;
+    frame[2 + len] = crc;
+
+    line[out++] = SLIP_END;
+    out += slip_put(&line[out], frame, 3 + len);
+    line[out++] = SLIP_END;
+    sdk_host_uart_rx(line, out);
+}
+
+static void frame_send(uint8_t type, const void * p_payload, uint32_t len){
+    frame_send_crc(type, p_payload, len, 0);
+}
+
+static void frame_add(void){
+    uint16_t crc;
+
+    CHECK(m_rx_len >= 3);
+    crc = crc16_update(CRC16_CCITT_INIT, m_rx, m_rx_len - 2);
+    CHECK(m_rx[m_rx_len - 2] == (uint8_t)(crc >> 8) && m_rx[m_rx_len - 1] == (uint8_t)crc);
+    CHECK(m_frame_count < FRAMES);
+    memcpy(m_frames[m_frame_count].data, m_rx, m_rx_len - 2);
+    m_frames[m_frame_count].len = m_rx_len - 2;
+    m_frame_count++;
+}
+
+// Runs the device for ms and decodes what it sent meanwhile
+static void run_ms(uint32_t ms){
+    uint8_t line[256];
+    uint32_t len;
+
+    phone_run_ms(ms);
+    while((len = sdk_host_uart_tx(line, sizeof(line))) > 0){
+        for(uint32_t i = 0; i < len; i++){
+            uint8_t byte = line[i];
+
+            if(byte == SLIP_END){
+                if(m_rx_len){
+                    frame_add();
+                }
+                m_rx_len = 0;
+                continue;
+            }
+            if(m_rx_escaped){
+                m_rx_escaped = false;
+                CHECK(byte == SLIP_ESC_END || byte == SLIP_ESC_ESC);
+                byte = (byte == SLIP_ESC_END) ? SLIP_END : SLIP_ESC;
+            } else if(byte == SLIP_ESC){
+                m_rx_escaped = true;
+                continue;
+            }
+            CHECK(m_rx_len < sizeof(m_rx));
+            m_rx[m_rx_len++] = byte;
+        }
+    }
+}
+
+static void frames_clear(void){
+    m_frame_count = 0;
+}
+
+static bool frame_is(uint32_t index, uint8_t type, const uint8_t * p_payload, uint8_t len){
+    CHECK(index < m_frame_count);
+    return m_frames[index].data[0] == type && m_frames[index].len == 1 + len
+        && memcmp(&m_frames[index].data[1], p_payload, len) == 0;
+}
+
+static void put_be64(uint8_t * p_out, uint64_t value){
+    for(int i = 0; i < 8; i++){
+        p_out[i] = value >> ((7 - i) * 8);
+    }
+}
+
+static void passcode_send(uint64_t passcode){
+    uint8_t payload[8];
+
+    put_be64(payload, passcode);
+    frame_send(UART_CMD_FRAME_PASSCODE, payload, sizeof(payload));
+}
+
+// A frame that must be dropped, then a good one to show the receiver is back in step
+static void dropped_check(const uint8_t * p_line, uint32_t len){
+    frames_clear();
+    sdk_host_uart_rx(p_line, len);
+    run_ms(50);
+    CHECK(m_frame_count == 0);
+
+    frame_send(UART_CMD_FRAME_OPEN, NULL, 0);
+    run_ms(50);
+    CHECK(m_frame_count == 1 && frame_is(0, UART_CMD_FRAME_CLOSED, NULL, 0));
+}
+
+int main(void){
+    static const uint64_t seed[4] = { 0x0123456789ABCDEFULL, 0x1111111111111111ULL,
+                                      0x2222222222222222ULL, 0x3333333333333333ULL };
+    static const uint8_t seed_received[] = { 1 };
+    static const uint8_t seed_set[] = { 2 };
+    static const uint8_t passcode_correct[] = { 3 };
+    uint64_t key[4];
+    uint64_t draws[2];
+    uint8_t command[14];
+    uint8_t line[64];
+    uint32_t len;
+
+    phone_init();
+    run_ms(10);
+    CHECK(m_frame_count == 0);
+
+    // One link at a time, the phone holds it
+    phone_connect();
+    frame_send(UART_CMD_FRAME_OPEN, NULL, 0);
+    run_ms(50);
+    CHECK(m_frame_count == 1 && frame_is(0, UART_CMD_FRAME_CLOSED, NULL, 0));
+    CHECK(!uart_cmd_session_open() && current_state_get() == ST_UNSEEDED_CONNECTED);
+    phone_disconnect();
+    CHECK(current_state_get() == ST_UNSEEDED);
+
+    frames_clear();
+    frame_send(UART_CMD_FRAME_OPEN, NULL, 0);
+    run_ms(50);
+    CHECK(m_frame_count == 1 && frame_is(0, UART_CMD_FRAME_OPENED, NULL, 0));
+    CHECK(uart_cmd_session_open() && current_state_get() == ST_UNSEEDED_CONNECTED);
+
+    // Now the session holds it
+    sdk_host_ble_connect(PHONE_CONN_INTERVAL);
+    run_ms(50);
+    CHECK(!sdk_host_ble_connected());
+    CHECK(uart_cmd_session_open() && current_state_get() == ST_UNSEEDED_CONNECTED);
+
+    // The seed, each write answered in a frame of its own
+    memcpy(key, seed, sizeof(key));
+    prng_seed(key, 4);
+    for(uint32_t i = 0; i < 2; i++){
+        draws[i] = prng_next64();
+    }
+    frames_clear();
+    for(int i = 0; i < 4; i++){
+        passcode_send(seed[i]);
+        run_ms(20);
+    }
+    CHECK(m_frame_count == 4);
+    for(int i = 0; i < 3; i++){
+        CHECK(frame_is(i, UART_CMD_FRAME_RESPONSE, seed_received, sizeof(seed_received)));
+    }
+    CHECK(frame_is(3, UART_CMD_FRAME_RESPONSE, seed_set, sizeof(seed_set)));
+    CHECK(current_state_get() == ST_CONNECTED);
+
+    // A bad CRC is dropped unanswered and the passcode never arrives
+    frames_clear();
+    put_be64(command, draws[1]);
+    frame_send_crc(UART_CMD_FRAME_PASSCODE, command, 8, 0x0100);
+    run_ms(50);
+    CHECK(m_frame_count == 0 && current_state_get() == ST_CONNECTED);
+
+    // So are a bad escape and more bytes than any frame holds
+    len = 0;
+    line[len++] = SLIP_END;
+    line[len++] = UART_CMD_FRAME_OPEN;
+    line[len++] = SLIP_ESC;
+    line[len++] = 0x01;
+    line[len++] = 0x00;
+    line[len++] = 0x00;
+    line[len++] = SLIP_END;
+    dropped_check(line, len);
+
+    len = 0;
+    line[len++] = SLIP_END;
+    line[len++] = UART_CMD_FRAME_OPEN;
+    for(uint32_t i = 0; i < 40; i++){
+        line[len++] = 0x55;
+    }
+    line[len++] = SLIP_END;
+    dropped_check(line, len);
+    CHECK(current_state_get() == ST_CONNECTED);
+
+    frames_clear();
+    passcode_send(draws[1]);
+    run_ms(20);
+    CHECK(m_frame_count == 1 && frame_is(0, UART_CMD_FRAME_RESPONSE, passcode_correct, sizeof(passcode_correct)));
+    CHECK(current_state_get() == ST_UNLOCKED);
+
+    // The ack and the millis after it come back in the one frame
+    frames_clear();
+    put_be64(&command[0], draws[1]);
+    command[8] = OP_GET_MILLIS;
+    memset(&command[9], 0, 4);
+    command[13] = 0x42;
+    frame_send(UART_CMD_FRAME_COMMAND, command, sizeof(command));
+    run_ms(20);
+    CHECK(m_frame_count == 1 && m_frames[0].data[0] == UART_CMD_FRAME_RESPONSE && m_frames[0].len == 1 + 6);
+    CHECK(m_frames[0].data[1] == 0x42 && m_frames[0].data[2] == 5);
+
+    frames_clear();
+    frame_send(UART_CMD_FRAME_CLOSE, NULL, 0);
+    run_ms(50);
+    CHECK(m_frame_count == 1 && frame_is(0, UART_CMD_FRAME_CLOSED, NULL, 0));
+    CHECK(!uart_cmd_session_open() && current_state_get() == ST_IDLE);
+
+    // Writes outside a session are refused, and phones are welcome again
+    frames_clear();
+    passcode_send(draws[1]);
+    run_ms(50);
+    CHECK(m_frame_count == 1 && frame_is(0, UART_CMD_FRAME_CLOSED, NULL, 0));
+    phone_connect();
+    CHECK(sdk_host_ble_connected() && current_state_get() == ST_CONNECTED);
+
+    printf("uart commands: ok\n");
+    return 0;
+}
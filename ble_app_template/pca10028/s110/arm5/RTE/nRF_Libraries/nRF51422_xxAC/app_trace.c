@@ -1,82 +1,169 @@
-/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
- *
- * The information contained herein is property of Nordic Semiconductor ASA.
- * Terms and conditions of usage are described in detail in NORDIC
- * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
- *
- * Licensees are granted free, non-transferable use of the information. NO
- * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
- * the file.
- *
- */
-
-#include <stdio.h>
-#include <stdint.h>
-#include <string.h>
-#include <stdarg.h>
-
-
-#ifdef ENABLE_DEBUG_LOG_SUPPORT
-#include "app_uart.h"
-#include "nordic_common.h"
-#include "boards.h"
-#include "app_trace.h"
-#include "app_error.h"
-
-#ifndef UART_TX_BUF_SIZE
-    #define UART_TX_BUF_SIZE 256                         /**< UART TX buffer size. */
-#endif
-#ifndef UART_RX_BUF_SIZE
-    #define UART_RX_BUF_SIZE 1                           /**< UART RX buffer size. */
-#endif
-__WEAK void uart_error_handle(app_uart_evt_t * p_event)
-{
-    if (p_event->evt_type == APP_UART_COMMUNICATION_ERROR)
-    {
-        APP_ERROR_HANDLER(p_event->data.error_communication);
-    }
-    else if (p_event->evt_type == APP_UART_FIFO_ERROR)
-    {
-        APP_ERROR_HANDLER(p_event->data.error_code);
-    }
-}
-
-void app_trace_init(void)
-{
-    uint32_t err_code = NRF_SUCCESS;
-    const app_uart_comm_params_t comm_params =  
-    {
-        RX_PIN_NUMBER, 
-        TX_PIN_NUMBER, 
-        RTS_PIN_NUMBER, 
-        CTS_PIN_NUMBER, 
-        APP_UART_FLOW_CONTROL_DISABLED, 
-        false, 
-        UART_BAUDRATE_BAUDRATE_Baud38400
-    }; 
-        
-    APP_UART_FIFO_INIT(&comm_params, 
-                       UART_RX_BUF_SIZE, 
-                       UART_TX_BUF_SIZE, 
-                       uart_error_handle, 
-                       APP_IRQ_PRIORITY_LOW,
-                       err_code);
-    UNUSED_VARIABLE(err_code);
-}
-
-void app_trace_dump(uint8_t * p_buffer, uint32_t len)
-{
-    app_trace_log("\r\n");
-    for (uint32_t index = 0; index <  len; index++)
-    {
-        app_trace_log("0x%02X ", p_buffer[index]);
-    }
-    app_trace_log("\r\n");
-}
-
-#endif // ENABLE_DEBUG_LOG_SUPPORT
-
-/**
- *@}
- **/
-
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdarg.h>
+
+
+#ifdef ENABLE_DEBUG_LOG_SUPPORT
+#include "app_uart.h"
+#include "nordic_common.h"
+#include "boards.h"
+#include "app_trace.h"
+#include "app_error.h"
+#include "app_util_platform.h"
+
+#ifdef UART_COMMANDS
+    #error "app_trace and the UART command channel both need UART0."
+#endif
+
+#ifndef UART_TX_BUF_SIZE
+    #define UART_TX_BUF_SIZE 256                         /**< UART TX buffer size. */
+#endif
+#ifndef UART_RX_BUF_SIZE
+    #define UART_RX_BUF_SIZE 1                           /**< UART RX buffer size. */
+#endif
+#ifndef APP_TRACE_BAUDRATE
+    #define APP_TRACE_BAUDRATE UART_BAUDRATE_BAUDRATE_Baud115200 /**< Any UART_BAUDRATE_BAUDRATE_BaudXXX, up to Baud1M. */
+#endif
+
+#define DROP_REPORT_TAIL " bytes dropped>\r\n"
+#define DROP_REPORT_MAX  (3 + 10 + sizeof(DROP_REPORT_TAIL)) /**< Longest "\r\n<N bytes dropped>\r\n" report. */
+
+static uint32_t m_tx_dropped;                            /**< Bytes dropped since the last in-band report. */
+static uint32_t m_tx_dropped_total;                      /**< Bytes dropped since app_trace_init(). */
+static uint32_t m_rx_errors;                             /**< Line and RX FIFO errors since app_trace_init(). */
+
+/**@brief Trace is output only, so noise or an overrun on the idle RX line is counted rather than
+ *        treated as fatal.
+ */
+__WEAK void uart_error_handle(app_uart_evt_t * p_event)
+{
+    if (p_event->evt_type == APP_UART_COMMUNICATION_ERROR ||
+        p_event->evt_type == APP_UART_FIFO_ERROR)
+    {
+        m_rx_errors++;
+    }
+}
+
+void app_trace_init(void)
+{
+    uint32_t err_code = NRF_SUCCESS;
+    const app_uart_comm_params_t comm_params =  
+    {
+        RX_PIN_NUMBER, 
+        TX_PIN_NUMBER, 
+        RTS_PIN_NUMBER, 
+        CTS_PIN_NUMBER, 
+        APP_UART_FLOW_CONTROL_DISABLED, 
+        false, 
+        APP_TRACE_BAUDRATE
+    }; 
+        
+    m_tx_dropped       = 0;
+    m_tx_dropped_total = 0;
+    m_rx_errors        = 0;
+
+    APP_UART_FIFO_INIT(&comm_params, 
+                       UART_RX_BUF_SIZE, 
+                       UART_TX_BUF_SIZE, 
+                       uart_error_handle, 
+                       APP_IRQ_PRIORITY_LOW,
+                       err_code);
+    UNUSED_VARIABLE(err_code);
+}
+
+/**@brief Writes "\r\n<N bytes dropped>\r\n" to the trace once all of it fits the TX buffer.
+ *
+ * @details Formatted by hand, since this runs from within printf().
+ */
+static void drop_report(void)
+{
+    char     report[DROP_REPORT_MAX];
+    char     digits[10];
+    uint32_t count = m_tx_dropped;
+    uint32_t len   = 0;
+    uint32_t ndigits = 0;
+
+    if (app_uart_tx_free() < sizeof(report))
+    {
+        return;
+    }
+
+    do
+    {
+        digits[ndigits++] = '0' + (count % 10);
+        count /= 10;
+    } while (count != 0);
+
+    report[len++] = '\r';
+    report[len++] = '\n';
+    report[len++] = '<';
+    while (ndigits != 0)
+    {
+        report[len++] = digits[--ndigits];
+    }
+    memcpy(&report[len], DROP_REPORT_TAIL, sizeof(DROP_REPORT_TAIL) - 1);
+    len += sizeof(DROP_REPORT_TAIL) - 1;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        UNUSED_VARIABLE(app_uart_put((uint8_t)report[i]));
+    }
+    m_tx_dropped = 0;
+}
+
+void app_trace_put(uint8_t byte)
+{
+    // printf() may be called from the main loop and from interrupt handlers.
+    CRITICAL_REGION_ENTER();
+    if (m_tx_dropped != 0)
+    {
+        drop_report();
+    }
+    if (m_tx_dropped != 0 || app_uart_put(byte) != NRF_SUCCESS)
+    {
+        // Once anything is dropped, keep dropping until the report fits, so it marks the gap.
+        m_tx_dropped++;
+        m_tx_dropped_total++;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+uint32_t app_trace_dropped_get(void)
+{
+    return m_tx_dropped_total;
+}
+
+uint32_t app_trace_rx_errors_get(void)
+{
+    return m_rx_errors;
+}
+
+void app_trace_dump(uint8_t * p_buffer, uint32_t len)
+{
+    app_trace_log("\r\n");
+    for (uint32_t index = 0; index <  len; index++)
+    {
+        app_trace_log("0x%02X ", p_buffer[index]);
+    }
+    app_trace_log("\r\n");
+}
+
+#endif // ENABLE_DEBUG_LOG_SUPPORT
+
+/**
+ *@}
+ **/
+
@@ -0,0 +1,113 @@
+#include <stddef.h>
+#include "conn_policy.h"
+#include "logger.h"
+#include "power_profile.h"
+#include "ble_gap.h"
+#include "ble_conn_params.h"
+#include "app_timer.h"
+#include "app_util.h"
+#include "app_error.h"
+
+#define CONN_POLICY_SLOW_DELAY APP_TIMER_TICKS(5000, 0)
+
+// Same supervision timeout for both so a switch never shortens it below
+// (1 + slave latency) * max interval * 2
+static const ble_gap_conn_params_t profiles[NUM_CONN_PROFILES] = {
+    [CONN_PROFILE_FAST] = {
+        .min_conn_interval = MSEC_TO_UNITS(10, UNIT_1_25_MS),
+        .max_conn_interval = MSEC_TO_UNITS(10, UNIT_1_25_MS),
+        .slave_latency     = 0,
+        .conn_sup_timeout  = MSEC_TO_UNITS(4000, UNIT_10_MS),
+    },
+    [CONN_PROFILE_SLOW] = {
+        .min_conn_interval = MSEC_TO_UNITS(100, UNIT_1_25_MS),
+        .max_conn_interval = MSEC_TO_UNITS(200, UNIT_1_25_MS),
+        .slave_latency     = 4,
+        .conn_sup_timeout  = MSEC_TO_UNITS(4000, UNIT_10_MS),
+    },
+};
+
+// Fast while the phone is seeding. Otherwise a connected phone sits on
+// the slow profile and only passcodes, opcodes, operands and commands
+// bring the fast one back, see conn_policy_activity()
+static const CONN_PROFILE state_profiles[NUM_STATES] = {
+    [ST_INVALID]            = CONN_PROFILE_NONE,
+    [ST_UNSEEDED]           = CONN_PROFILE_NONE,
+    [ST_UNSEEDED_CONNECTED] = CONN_PROFILE_FAST,
+    [ST_IDLE]               = CONN_PROFILE_NONE,
+    [ST_CONNECTED]          = CONN_PROFILE_SLOW,
+    [ST_LOCKED]             = CONN_PROFILE_SLOW,
+    [ST_UNLOCKED]           = CONN_PROFILE_SLOW,
+};
+
+static app_timer_id_t m_slow_timer_id;
+static volatile CONN_PROFILE m_requested = CONN_PROFILE_NONE;
+static CONN_PROFILE m_current = CONN_PROFILE_NONE;
+
+static void profile_apply(CONN_PROFILE profile){
+    ble_gap_conn_params_t params = profiles[profile];
+
+    if(profile == m_current){
+        return;
+    }
+    m_current = profile;
+
+    LOG_DEBUG("Switching to connection profile %d", profile);
+    uint32_t err_code = ble_conn_params_change_conn_params(&params);
+    if(err_code != NRF_SUCCESS){
+        LOG_WARN("Connection parameter change failed %d", err_code);
+    }
+}
+
+static void slow_timeout(void* p_context){
+    power_profile_wake_reason(POWER_WAKE_TIMER);
+    // A fast request may have raced the timer
+    if(m_requested == CONN_PROFILE_SLOW){
+        profile_apply(CONN_PROFILE_SLOW);
+    }
+}
+
+void conn_policy_init(void){
+    uint32_t err_code = app_timer_create(&m_slow_timer_id, APP_TIMER_MODE_SINGLE_SHOT, slow_timeout);
+    APP_ERROR_CHECK(err_code);
+}
+
+void conn_policy_state_changed(STATE state){
+    CONN_PROFILE profile = (state < NUM_STATES) ? state_profiles[state] : CONN_PROFILE_NONE;
+
+    if(profile == m_requested){
+        return;
+    }
+    m_requested = profile;
+
+    switch(profile){
+        case CONN_PROFILE_FAST:
+            app_timer_stop(m_slow_timer_id);
+            profile_apply(CONN_PROFILE_FAST);
+            break;
+
+        case CONN_PROFILE_SLOW:
+            app_timer_restart(m_slow_timer_id, CONN_POLICY_SLOW_DELAY, NULL);
+            break;
+
+        default:
+            // The link is gone, the next connection starts from the PPCP again
+            app_timer_stop(m_slow_timer_id);
+            m_current = CONN_PROFILE_NONE;
+            break;
+    }
+}
+
+void conn_policy_activity(void){
+    // Only a link settling on the slow profile has anything to speed up
+    if(m_requested != CONN_PROFILE_SLOW){
+        return;
+    }
+
+    profile_apply(CONN_PROFILE_FAST);
+    app_timer_restart(m_slow_timer_id, CONN_POLICY_SLOW_DELAY, NULL);
+}
+
+CONN_PROFILE conn_policy_current(void){
+    return m_current;
+}
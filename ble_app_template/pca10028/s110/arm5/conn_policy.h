@@ -0,0 +1,29 @@
+/*
+ *  Connection Parameter Policy
+ *
+ *  Picks the connection parameters from the state machine STATE and the
+ *  phone's writes: a short interval while seeding or while a command
+ *  exchange is going on, and a long interval with slave latency while the
+ *  phone just sits connected. Moving to the fast profile is immediate,
+ *  falling back to the slow one waits for CONN_POLICY_SLOW_DELAY after the
+ *  last write so back-to-back commands don't renegotiate.
+ */
+
+#ifndef CONN_POLICY_H__
+#define CONN_POLICY_H__
+
+#include <stdint.h>
+#include "ign_state_machine.h"
+
+typedef enum {  CONN_PROFILE_NONE,                      // Not connected, leave the parameters alone
+                CONN_PROFILE_FAST,
+                CONN_PROFILE_SLOW,
+                NUM_CONN_PROFILES
+} CONN_PROFILE;
+
+void conn_policy_init(void);
+void conn_policy_state_changed(STATE state);
+void conn_policy_activity(void);                // A passcode, opcode, operand or command came in
+CONN_PROFILE conn_policy_current(void);
+
+#endif
@@ -0,0 +1,12 @@
+#include "crc16_ccitt.h"
+
+uint16_t crc16_update(uint16_t crc, const uint8_t* p_data, uint32_t size){
+    for(uint32_t i = 0; i < size; i++){
+        crc  = (uint8_t)(crc >> 8) | (crc << 8);
+        crc ^= p_data[i];
+        crc ^= (uint8_t)(crc & 0xFF) >> 4;
+        crc ^= (crc << 8) << 4;
+        crc ^= ((crc & 0xFF) << 4) << 1;
+    }
+    return crc;
+}
@@ -0,0 +1,17 @@
+/*
+ *  CRC-16-CCITT
+ *
+ *  Same polynomial (0x1021) and bit order as the SDK's crc16_compute(), start
+ *  from 0xFFFF. Used for the key/value store records and the UART frames.
+ */
+
+#ifndef CRC16_CCITT_H__
+#define CRC16_CCITT_H__
+
+#include <stdint.h>
+
+#define CRC16_CCITT_INIT 0xFFFF
+
+uint16_t crc16_update(uint16_t crc, const uint8_t* p_data, uint32_t size);
+
+#endif
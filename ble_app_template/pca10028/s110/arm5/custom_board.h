@@ -1,91 +1,104 @@
-/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
- *
- * The information contained herein is property of Nordic Semiconductor ASA.
- * Terms and conditions of usage are described in detail in NORDIC
- * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
- *
- * Licensees are granted free, non-transferable use of the information. NO
- * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
- * the file.
- *
- */
-#ifndef PCA10028_H
-#define PCA10028_H
-
-// LEDs definitions for PCA10028
-#define LEDS_NUMBER    4
-
-#define LED_START      4
-#define LED_1          4
-#define LED_2          5
-#define LED_3          8
-#define LED_4          10
-#define LED_STOP       10
-
-#define LEDS_LIST { LED_1, LED_2, LED_3, LED_4 }
-
-#define BSP_LED_0      LED_1
-#define BSP_LED_1      LED_2
-#define BSP_LED_2      LED_3
-#define BSP_LED_3      LED_4
-
-#define BSP_LED_0_MASK (1<<BSP_LED_0)
-#define BSP_LED_1_MASK (1<<BSP_LED_1)
-#define BSP_LED_2_MASK (1<<BSP_LED_2)
-#define BSP_LED_3_MASK (1<<BSP_LED_3)
-
-#define LEDS_MASK      (BSP_LED_0_MASK | BSP_LED_1_MASK | BSP_LED_2_MASK | BSP_LED_3_MASK)
-/* all LEDs are lit when GPIO is low */
-#define LEDS_INV_MASK  LEDS_MASK
-
-#define BUTTONS_NUMBER 0
-
-#define RX_PIN_NUMBER  11
-#define TX_PIN_NUMBER  9
-#define CTS_PIN_NUMBER 10
-#define RTS_PIN_NUMBER 8
-#define HWFC           true
-
-#define SPIS_MISO_PIN  28    // SPI MISO signal. 
-#define SPIS_CSN_PIN   12    // SPI CSN signal. 
-#define SPIS_MOSI_PIN  25    // SPI MOSI signal. 
-#define SPIS_SCK_PIN   29    // SPI SCK signal. 
-
-#define SPIM0_SCK_PIN       4     /**< SPI clock GPIO pin number. */
-#define SPIM0_MOSI_PIN      1     /**< SPI Master Out Slave In GPIO pin number. */
-#define SPIM0_MISO_PIN      3     /**< SPI Master In Slave Out GPIO pin number. */
-#define SPIM0_SS_PIN        2     /**< SPI Slave Select GPIO pin number. */
-
-#define SPIM1_SCK_PIN       15     /**< SPI clock GPIO pin number. */
-#define SPIM1_MOSI_PIN      12     /**< SPI Master Out Slave In GPIO pin number. */
-#define SPIM1_MISO_PIN      14     /**< SPI Master In Slave Out GPIO pin number. */
-#define SPIM1_SS_PIN        13     /**< SPI Slave Select GPIO pin number. */
-
-// serialization APPLICATION board
-#define SER_APP_RX_PIN              12    // UART RX pin number.
-#define SER_APP_TX_PIN              13    // UART TX pin number.
-#define SER_APP_CTS_PIN             15    // UART Clear To Send pin number.
-#define SER_APP_RTS_PIN             14    // UART Request To Send pin number.
-
-#define SER_APP_SPIM0_SCK_PIN       29     // SPI clock GPIO pin number.
-#define SER_APP_SPIM0_MOSI_PIN      25     // SPI Master Out Slave In GPIO pin number
-#define SER_APP_SPIM0_MISO_PIN      28     // SPI Master In Slave Out GPIO pin number
-#define SER_APP_SPIM0_SS_PIN        12     // SPI Slave Select GPIO pin number
-#define SER_APP_SPIM0_RDY_PIN       14     // SPI READY GPIO pin number
-#define SER_APP_SPIM0_REQ_PIN       13     // SPI REQUEST GPIO pin number
-
-// serialization CONNECTIVITY board
-#define SER_CON_RX_PIN              13    // UART RX pin number.
-#define SER_CON_TX_PIN              12    // UART TX pin number.
-#define SER_CON_CTS_PIN             14    // UART Clear To Send pin number. Not used if HWFC is set to false.
-#define SER_CON_RTS_PIN             15    // UART Request To Send pin number. Not used if HWFC is set to false.
-
-
-#define SER_CON_SPIS_SCK_PIN        29    // SPI SCK signal.
-#define SER_CON_SPIS_MOSI_PIN       25    // SPI MOSI signal.
-#define SER_CON_SPIS_MISO_PIN       28    // SPI MISO signal.
-#define SER_CON_SPIS_CSN_PIN        12    // SPI CSN signal.
-#define SER_CON_SPIS_RDY_PIN        14    // SPI READY GPIO pin number.
-#define SER_CON_SPIS_REQ_PIN        13    // SPI REQUEST GPIO pin number.
-
-#endif // PCA10028_H
+/* Copyright (c) 2014 Nordic Semiconductor. All Rights Reserved.
+ *
+ * The information contained herein is property of Nordic Semiconductor ASA.
+ * Terms and conditions of usage are described in detail in NORDIC
+ * SEMICONDUCTOR STANDARD SOFTWARE LICENSE AGREEMENT.
+ *
+ * Licensees are granted free, non-transferable use of the information. NO
+ * WARRANTY of ANY KIND is provided. This heading must NOT be removed from
+ * the file.
+ *
+ */
+#ifndef PCA10028_H
+#define PCA10028_H
+
+// LEDs definitions for PCA10028
+#define LEDS_NUMBER    4
+
+#define LED_START      4
+#define LED_1          4
+#define LED_2          5
+#define LED_3          8
+#define LED_4          10
+#define LED_STOP       10
+
+#define LEDS_LIST { LED_1, LED_2, LED_3, LED_4 }
+
+#define BSP_LED_0      LED_1
+#define BSP_LED_1      LED_2
+#define BSP_LED_2      LED_3
+#define BSP_LED_3      LED_4
+
+#define BSP_LED_0_MASK (1<<BSP_LED_0)
+#define BSP_LED_1_MASK (1<<BSP_LED_1)
+#define BSP_LED_2_MASK (1<<BSP_LED_2)
+#define BSP_LED_3_MASK (1<<BSP_LED_3)
+
+#define LEDS_MASK      (BSP_LED_0_MASK | BSP_LED_1_MASK | BSP_LED_2_MASK | BSP_LED_3_MASK)
+/* all LEDs are lit when GPIO is low */
+#define LEDS_INV_MASK  LEDS_MASK
+
+// Vehicle outputs, the panic output drives the LED and a second pin
+#define PANIC_PIN      11
+#define OUT_LOCK_MASK     BSP_LED_0_MASK
+#define OUT_IGNITION_MASK BSP_LED_1_MASK
+#define OUT_STARTER_MASK  BSP_LED_2_MASK
+#define OUT_PANIC_MASK    (BSP_LED_3_MASK | (1 << PANIC_PIN))
+
+#define BUTTONS_NUMBER 0
+
+// Trace UART (app_trace.c), which never reads: RX sits on unused pin 7, clear
+// of the panic pin. RTS and CTS only matter with flow control, which it leaves off.
+#define RX_PIN_NUMBER  7
+#define TX_PIN_NUMBER  9
+#define CTS_PIN_NUMBER 10
+#define RTS_PIN_NUMBER 8
+#define HWFC           true
+
+// Command channel (uart_cmd.h), clear of the panic pin on 11 and the LEDs
+#define UART_CMD_RX_PIN 12
+#define UART_CMD_TX_PIN 13
+
+#define SPIS_MISO_PIN  28    // SPI MISO signal. 
+#define SPIS_CSN_PIN   12    // SPI CSN signal. 
+#define SPIS_MOSI_PIN  25    // SPI MOSI signal. 
+#define SPIS_SCK_PIN   29    // SPI SCK signal. 
+
+#define SPIM0_SCK_PIN       4     /**< SPI clock GPIO pin number. */
+#define SPIM0_MOSI_PIN      1     /**< SPI Master Out Slave In GPIO pin number. */
+#define SPIM0_MISO_PIN      3     /**< SPI Master In Slave Out GPIO pin number. */
+#define SPIM0_SS_PIN        2     /**< SPI Slave Select GPIO pin number. */
+
+#define SPIM1_SCK_PIN       15     /**< SPI clock GPIO pin number. */
+#define SPIM1_MOSI_PIN      12     /**< SPI Master Out Slave In GPIO pin number. */
+#define SPIM1_MISO_PIN      14     /**< SPI Master In Slave Out GPIO pin number. */
+#define SPIM1_SS_PIN        13     /**< SPI Slave Select GPIO pin number. */
+
+// serialization APPLICATION board
+#define SER_APP_RX_PIN              12    // UART RX pin number.
+#define SER_APP_TX_PIN              13    // UART TX pin number.
+#define SER_APP_CTS_PIN             15    // UART Clear To Send pin number.
+#define SER_APP_RTS_PIN             14    // UART Request To Send pin number.
+
+#define SER_APP_SPIM0_SCK_PIN       29     // SPI clock GPIO pin number.
+#define SER_APP_SPIM0_MOSI_PIN      25     // SPI Master Out Slave In GPIO pin number
+#define SER_APP_SPIM0_MISO_PIN      28     // SPI Master In Slave Out GPIO pin number
+#define SER_APP_SPIM0_SS_PIN        12     // SPI Slave Select GPIO pin number
+#define SER_APP_SPIM0_RDY_PIN       14     // SPI READY GPIO pin number
+#define SER_APP_SPIM0_REQ_PIN       13     // SPI REQUEST GPIO pin number
+
+// serialization CONNECTIVITY board
+#define SER_CON_RX_PIN              13    // UART RX pin number.
+#define SER_CON_TX_PIN              12    // UART TX pin number.
+#define SER_CON_CTS_PIN             14    // UART Clear To Send pin number. Not used if HWFC is set to false.
+#define SER_CON_RTS_PIN             15    // UART Request To Send pin number. Not used if HWFC is set to false.
+
+
+#define SER_CON_SPIS_SCK_PIN        29    // SPI SCK signal.
+#define SER_CON_SPIS_MOSI_PIN       25    // SPI MOSI signal.
+#define SER_CON_SPIS_MISO_PIN       28    // SPI MISO signal.
+#define SER_CON_SPIS_CSN_PIN        12    // SPI CSN signal.
+#define SER_CON_SPIS_RDY_PIN        14    // SPI READY GPIO pin number.
+#define SER_CON_SPIS_REQ_PIN        13    // SPI REQUEST GPIO pin number.
+
+#endif // PCA10028_H
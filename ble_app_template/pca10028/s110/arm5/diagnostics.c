@@ -0,0 +1,70 @@
+#include <string.h>
+#include "diagnostics.h"
+#include "logger.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+
+static diag_t m_diag;
+
+static uint8_t latency_bucket(uint32_t ticks){
+    uint8_t bucket = 0;
+    while(ticks && bucket < DIAG_LATENCY_BUCKETS - 1){
+        ticks >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static void histogram_add(uint16_t* histogram, uint32_t ticks){
+    uint16_t* count = &histogram[latency_bucket(ticks)];
+    if(*count != UINT16_MAX){
+        (*count)++;
+    }
+}
+
+void diag_event_queued(uint8_t depth){
+    if(depth > m_diag.queue_high_water){
+        m_diag.queue_high_water = depth;
+    }
+}
+
+void diag_event_processed(EVENT event, uint32_t queued_ticks, uint32_t start_ticks, uint32_t end_ticks){
+    uint32_t ticks;
+
+    if(event >= NUM_EVENTS){
+        return;
+    }
+
+    app_timer_cnt_diff_compute(start_ticks, queued_ticks, &ticks);
+    histogram_add(m_diag.queue_latency[event], ticks);
+
+    app_timer_cnt_diff_compute(end_ticks, start_ticks, &ticks);
+    histogram_add(m_diag.process_time[event], ticks);
+}
+
+void diag_wrong_passcode(void){
+    m_diag.wrong_passcodes++;
+}
+
+void diag_snapshot(diag_t* p_diag){
+    // The high water mark is written from the SoftDevice and timer interrupts
+    CRITICAL_REGION_ENTER();
+    memcpy(p_diag, &m_diag, sizeof(diag_t));
+    CRITICAL_REGION_EXIT();
+
+    p_diag->events_dropped = events_dropped();
+}
+
+void diag_dump(void){
+    LOG_INFO("Queue high water %d, %d events dropped, %d wrong passcodes",
+             m_diag.queue_high_water, events_dropped(), m_diag.wrong_passcodes);
+
+    for(int event = 0; event < NUM_EVENTS; event++){
+        for(int bucket = 0; bucket < DIAG_LATENCY_BUCKETS; bucket++){
+            if(m_diag.queue_latency[event][bucket] || m_diag.process_time[event][bucket]){
+                LOG_INFO("Event %d bucket %d: %d queued, %d processed", event, bucket,
+                         m_diag.queue_latency[event][bucket], m_diag.process_time[event][bucket]);
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+/*
+ *  State Machine Diagnostics
+ *
+ *  Runtime counters and latency histograms for the event queue. Updating them
+ *  costs a counter read and a few increments per event; they are only copied
+ *  out when the diagnostics characteristic is read or diag_dump() is called.
+ *
+ *  Latencies are in RTC1 ticks (30.5 us). Bucket 0 counts 0 ticks, bucket b
+ *  counts [2^(b-1), 2^b) ticks and the last bucket everything above that.
+ */
+
+#ifndef DIAGNOSTICS_H__
+#define DIAGNOSTICS_H__
+
+#include <stdint.h>
+#include "ign_state_machine.h"
+
+#define DIAG_LATENCY_BUCKETS 10
+
+// Read as is (little endian) from the diagnostics characteristic
+typedef struct {
+    uint16_t queue_latency[NUM_EVENTS][DIAG_LATENCY_BUCKETS];  // add_event() to process_event(), saturating
+    uint16_t process_time[NUM_EVENTS][DIAG_LATENCY_BUCKETS];   // time spent in process_event(), saturating
+    uint32_t events_dropped;                                   // events lost to a full event queue
+    uint32_t notifications_dropped;                            // responses lost to a full BOC TX queue
+    uint32_t wrong_passcodes;                                  // incorrect passcode guesses
+    uint8_t  queue_high_water;                                 // deepest the event queue has been
+    uint8_t  reserved[3];
+} diag_t;
+
+void diag_event_queued(uint8_t depth);
+void diag_event_processed(EVENT event, uint32_t queued_ticks, uint32_t start_ticks, uint32_t end_ticks);
+void diag_wrong_passcode(void);
+
+/* copies the current counters into p_diag, notifications_dropped is left to the caller */
+void diag_snapshot(diag_t* p_diag);
+
+/* logs the non-empty histograms and the counters over RTT */
+void diag_dump(void);
+
+#endif
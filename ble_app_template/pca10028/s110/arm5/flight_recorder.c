@@ -0,0 +1,71 @@
+#include <string.h>
+#include "flight_recorder.h"
+#include "logger.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "nrf.h"
+
+#define FR_TICKS_MASK 0x00FFFFFF
+
+static void record_add(FR_TYPE type, uint8_t event, uint8_t states, int8_t response){
+    flight_recorder_t* p_fr = FLIGHT_RECORDER;
+    fr_record_t record;
+    uint32_t ticks;
+
+    app_timer_cnt_get(&ticks);
+    record.time = (ticks & FR_TICKS_MASK) | ((uint32_t)p_fr->boots << 24);
+    record.type = type;
+    record.event = event;
+    record.states = states;
+    record.response = response;
+
+    // Events are queued from interrupts and processed from the main loop
+    CRITICAL_REGION_ENTER();
+    p_fr->records[p_fr->head] = record;
+    if(++p_fr->head >= FR_RECORDS){
+        p_fr->head = 0;
+        p_fr->wrapped = 1;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+static uint8_t states_pack(STATE old_state, STATE new_state){
+    return (uint8_t)((old_state << 4) | (new_state & 0x0F));
+}
+
+// Must run before the SoftDevice is enabled, it reads and clears RESETREAS
+void flight_recorder_init(void){
+    flight_recorder_t* p_fr = FLIGHT_RECORDER;
+    uint32_t reset_reason = NRF_POWER->RESETREAS;
+
+    NRF_POWER->RESETREAS = reset_reason;
+
+    if(p_fr->magic != FR_MAGIC || p_fr->head >= FR_RECORDS){
+        memset(p_fr, 0, sizeof(flight_recorder_t));
+        p_fr->magic = FR_MAGIC;
+    } else {
+        p_fr->boots++;
+    }
+
+    LOG_INFO("Flight recorder boot %d, reset reason %08X", p_fr->boots, reset_reason);
+    record_add(FR_BOOT, (uint8_t)((reset_reason & 0x0F) | ((reset_reason >> 12) & 0x70)), 0, 0);
+}
+
+void flight_recorder_event_queued(EVENT event, STATE state, bool dropped){
+    record_add(dropped ? FR_DROPPED : FR_QUEUED, event, states_pack(state, state), 0);
+}
+
+void flight_recorder_event_processed(EVENT event, STATE old_state, STATE new_state, int8_t response){
+    record_add(FR_PROCESSED, event, states_pack(old_state, new_state), response);
+}
+
+void flight_recorder_error(uint32_t error_code, uint32_t line_num){
+    record_add(FR_ERROR, (uint8_t)error_code, (uint8_t)(line_num >> 8), (int8_t)line_num);
+}
+
+void flight_recorder_snapshot(flight_recorder_t* p_out){
+    // Records are added from the main loop and from interrupts
+    CRITICAL_REGION_ENTER();
+    memcpy(p_out, FLIGHT_RECORDER, sizeof(flight_recorder_t));
+    CRITICAL_REGION_EXIT();
+}
@@ -0,0 +1,68 @@
+/*
+ *  Flight Recorder
+ *
+ *  Circular trace of the state machine kept in RAM the startup code never
+ *  initializes, so the last FR_RECORDS entries survive a warm reset (the
+ *  NVIC_SystemReset() in app_error_handler, a pin reset, a lockup) and can
+ *  be read back afterwards from the flight recorder characteristic or with a
+ *  debugger. tools/flight_recorder_decode.py turns a dump into text.
+ *
+ *  The RAM is not known to the linker: FR_RAM_ADDR..FR_RAM_ADDR+FR_RAM_SIZE
+ *  is left out of IRAM1 in the options of both targets and they must change
+ *  together.
+ *  A power-on reset leaves it random, which the magic word catches. The host
+ *  build (host/) points FR_RAM_ADDR at a buffer of its own.
+ */
+
+#ifndef FLIGHT_RECORDER_H__
+#define FLIGHT_RECORDER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ign_state_machine.h"
+
+#ifndef FR_RAM_ADDR
+#define FR_RAM_ADDR 0x20003E00
+#endif
+#define FR_RAM_SIZE 0x200
+#define FR_MAGIC 0x46524543                     // "FREC"
+
+typedef enum {  FR_BOOT,                        // event holds RESETREAS bits 0-3 and bits 16-18 shifted to 4-6
+                FR_QUEUED,                      // add_event(), states holds the current state twice
+                FR_DROPPED,                     // add_event() with the event queue full
+                FR_PROCESSED,                   // process_event(), response is the last code sent, 0 if none
+                FR_ERROR,                       // app_error_handler(), event is the low byte of the error
+                                                // code, states and response the line number (big endian)
+                NUM_FR_TYPES
+} FR_TYPE;
+
+typedef struct {
+        uint32_t time;                          // RTC1 ticks in the low 24 bits, boot count in the high 8
+        uint8_t type;                           // FR_TYPE
+        uint8_t event;                          // EVENT
+        uint8_t states;                         // Old STATE in the high nibble, new STATE in the low nibble
+        int8_t response;
+} fr_record_t;
+
+#define FR_RECORDS ((FR_RAM_SIZE - 8) / sizeof(fr_record_t))
+
+// Read as is (little endian) from the flight recorder characteristic
+typedef struct {
+        uint32_t magic;
+        uint16_t head;                          // Next record to write, the oldest one once wrapped
+        uint8_t boots;                          // Resets since the recorder was cleared
+        uint8_t wrapped;                        // Set once every record has been written
+        fr_record_t records[FR_RECORDS];
+} flight_recorder_t;
+
+#define FLIGHT_RECORDER ((flight_recorder_t *)FR_RAM_ADDR)
+
+void flight_recorder_init(void);
+void flight_recorder_event_queued(EVENT event, STATE state, bool dropped);
+void flight_recorder_event_processed(EVENT event, STATE old_state, STATE new_state, int8_t response);
+void flight_recorder_error(uint32_t error_code, uint32_t line_num);
+
+/* copies the recorder as it stands, between records */
+void flight_recorder_snapshot(flight_recorder_t* p_out);
+
+#endif
@@ -1,518 +1,1057 @@
-
-#include "ign_state_machine.h"
-
-#define CONNECTION_TIMEOUT_INTERVAL APP_TIMER_TICKS(60000, 0)
-#define PASSCODE_ROTATE_INTERVAL APP_TIMER_TICKS(30000, 0)
-#define STARTER_INTERVAL APP_TIMER_TICKS(80, 0)
-
-#define ENDIAN_SWAP_32( x )  (\
-              (( x & 0x000000FF ) << 24 ) \
-            | (( x & 0x0000FF00 ) << 8  ) \
-            | (( x & 0x00FF0000 ) >> 8  ) \
-            | (( x & 0xFF000000 ) >> 24 ) \
-            )
-
-queued_event_t* head = NULL;
-uint8_t queued_events = 0;
-uint8_t current_state = ST_UNSEEDED;
-uint64_t passcodes[3] = {0, 0, 0};
-ble_boc_t m_boc;
-
-static app_timer_id_t m_connection_timeout_timer_id;
-static app_timer_id_t m_passcode_rotate_timer_id;
-static app_timer_id_t m_starter_timer_id;
-
-uint32_t passcode_rotate_timer_start_ticks;
-
-void connection_timeout(void* p_context);
-void passcode_timeout(void* p_context);
-void starter_timeout(void* p_context);
-
-uint32_t app_timer_ms(uint32_t ticks)
-{
-    float numerator = (1.0f) * 1000.0f;
-    float denominator = (float)APP_TIMER_CLOCK_FREQ;
-    float ms_per_tick = numerator / denominator;
-
-    uint32_t ms = ms_per_tick * ticks;
-
-    return ms;
-}
-
-void op_invalid(uint32_t toggle);
-void op_lock(uint32_t toggle);
-void op_ignition(uint32_t toggle);
-void op_starter(uint32_t toggle);
-void op_panic(uint32_t toggle);
-void op_get_millis(uint32_t arg);
-void op_sync_timer(uint32_t arg);
-void op_sync_timer_adv(uint32_t arg);
-
-void (*operations[NUM_OPERATIONS])(uint32_t arg) = { op_invalid, op_lock, op_ignition, op_starter, op_panic, op_get_millis, op_sync_timer, op_sync_timer_adv };
-
-void state_machine_init(ble_boc_t boc){
-
-    uint32_t err_code;
-    err_code = app_timer_create(&m_connection_timeout_timer_id, APP_TIMER_MODE_SINGLE_SHOT, connection_timeout);
-    APP_ERROR_CHECK(err_code);
-
-    err_code = app_timer_create(&m_passcode_rotate_timer_id, APP_TIMER_MODE_REPEATED, passcode_timeout);
-    APP_ERROR_CHECK(err_code);
-	
-	  err_code = app_timer_create(&m_starter_timer_id, APP_TIMER_MODE_SINGLE_SHOT, starter_timeout);
-    APP_ERROR_CHECK(err_code);
-
-    m_boc = boc;
-}
-
-void add_event(EVENT event, void* data, uint8_t size){
-
-    LOG_INFO("Adding Event %s", evt_str[event]);
-
-    queued_event_t* new_event = malloc(sizeof(queued_event_t));
-    new_event->event = event;
-
-    new_event->data = malloc(size);
-    memcpy(new_event->data, data, size);
-    
-    new_event->next = NULL;
-    
-    queued_event_t* current = head;
-
-    if(head == NULL){
-        head = new_event;
-    } else {
-        while(current->next){
-            current = current->next;
-        }
-
-        current->next = new_event;
-    }
-
-    queued_events++;
-
-    LOG_DEBUG("%d Queued Events", queued_events);
-}
-
-
-
-void process_event(){
-
-    LOG_DEBUG("Processing Next Event");
-    LOG_DEBUG("Old state is %s", st_str[current_state]);
-
-    queued_event_t* event_to_process = head;
-
-    if(head->event >= NUM_EVENTS){
-        LOG_ERROR("Undefined Event %d Received", head->event);
-    } else {
-        LOG_DEBUG("Processing %s", evt_str[head->event]);   
-
-        static OPERATION selected_operation = OP_INVALID;
-
-        //Run the event
-        switch(head->event){
-            case EVT_INVALID:
-						{
-                LOG_ERROR("Tried to process invalid event");
-								int8_t response = -1;
-								ble_boc_response_update(&m_boc, &response, 1);
-                break;
-						}
-            case EVT_BUTTON_PRESS:
-				switch(current_state){
-					case ST_CONNECTED: case ST_UNLOCKED: case ST_UNSEEDED_CONNECTED: case ST_LOCKED:
-					{
-						uint32_t err_code = sd_ble_gap_disconnect(0, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
-						APP_ERROR_CHECK(err_code);
-					}
-					default:
-						app_timer_stop(m_passcode_rotate_timer_id);
-						LOG_DEBUG("Passcode Rotation Timer stopped due to Seed Reset");
-						current_state = ST_UNSEEDED;
-						break;
-				}
-            case EVT_PASSCODE_SET:
-                switch(current_state){
-                    case ST_UNSEEDED_CONNECTED:
-                    {
-                        static uint64_t seed[4] = {0LL, 0LL, 0LL, 0LL};
-                        static uint8_t number_of_seed_values = 0;
-                        uint64_t seed_value = 0LL;
-                        for(int i = 0; i < 8; i++){
-                            uint64_t temp = ((uint8_t *) head->data)[i];
-                            temp = temp << ((7 - i) * 8);
-                            seed_value += temp;
-                        }
-                        
-                        seed[number_of_seed_values] = seed_value;
-
-                        LOG_DEBUG("Seed Value (MSB) - %08X", seed_value >> 32); 
-                        LOG_DEBUG("Seed Value (LSB) - %08X", seed_value);
-
-                        number_of_seed_values++;
-
-                        LOG_DEBUG("Seed Values Received - %d", number_of_seed_values);
-
-                        //Seed Completed
-                        if(number_of_seed_values == 4){
-                            
-                            LOG_DEBUG("Final seed is ");
-                            for(int i = 0; i < 4; i++){
-                                LOG_DEBUG("%08X", seed[i] >> 32);
-                                LOG_DEBUG("%08X", seed[i]);
-                            }
-
-                            init_by_array64(seed, 4);
-
-                            //Reset Seed and Counter
-                            for(int i = 0; i < 4; i++){
-                                seed [i] = 0LL;
-                            }
-                            number_of_seed_values = 0;
-
-                            //Generate and record passcode
-                            passcodes[0] = genrand64_int64();
-														passcodes[1] = genrand64_int64();
-														passcodes[2] = genrand64_int64();
-                            LOG_INFO("Passcode Prev (MSB) - %08X", passcodes[0] >> 32);
-                            LOG_INFO("Passcode Prev (LSB) - %08X", passcodes[0]);
-                            LOG_INFO("Passcode Curr (MSB) - %08X", passcodes[1] >> 32);
-                            LOG_INFO("Passcode Curr (LSB) - %08X", passcodes[1]);
-                            LOG_INFO("Passcode Next (MSB) - %08X", passcodes[2] >> 32);
-                            LOG_INFO("Passcode Next (LSB) - %08X", passcodes[2]);
-
-                            uint32_t err_code;
-                            EVENT event = EVT_PASSCODE_TIMED_OUT;
-                            err_code = app_timer_start(m_passcode_rotate_timer_id, PASSCODE_ROTATE_INTERVAL, &event);
-                            APP_ERROR_CHECK(err_code);
-														
-														app_timer_cnt_get(&passcode_rotate_timer_start_ticks);
-
-                            //Send successful response
-														uint8_t response = 2;
-                            ble_boc_response_update(&m_boc, &response, 1);
-                            current_state = ST_CONNECTED;                       
-                        } else {
-														uint8_t response = 1;
-														ble_boc_response_update(&m_boc, &response, 1);
-												}
-                        break;
-                    }
-                    case ST_CONNECTED: case ST_LOCKED:
-                    {
-                        uint64_t guess = 0LL;
-                        for(int i = 0; i < 8; i++){
-                            uint64_t temp = ((uint8_t *) head->data)[i];
-                            temp = temp << ((7 - i) * 8);
-                            guess += temp;
-                        }
-
-                        if(guess == passcodes[0]){
-                            app_timer_stop(m_connection_timeout_timer_id);
-                            LOG_DEBUG("Connection Timeout Timer stopped due to Correct Passcode");
-                            current_state = ST_UNLOCKED;
-														uint8_t response = 6;
-                            ble_boc_response_update(&m_boc, &response, 1);
-												} else if (guess == passcodes[1]){
-														app_timer_stop(m_connection_timeout_timer_id);
-                            LOG_DEBUG("Connection Timeout Timer stopped due to Correct Passcode");
-                            current_state = ST_UNLOCKED;
-														uint8_t response = 3;
-                            ble_boc_response_update(&m_boc, &response, 1);
-												} else if (guess == passcodes[2]){
-														app_timer_stop(m_connection_timeout_timer_id);
-                            LOG_DEBUG("Connection Timeout Timer stopped due to Correct Passcode");
-                            current_state = ST_UNLOCKED;
-														uint8_t response = 7;
-                            ble_boc_response_update(&m_boc, &response, 1);													
-												} else {
-                            static uint8_t incorrect_attempts = 0;
-                            incorrect_attempts++;
-                            LOG_DEBUG("Incorrect passcode attempt");
-                            if(incorrect_attempts >= 5){
-                                uint32_t err_code = sd_ble_gap_disconnect(0, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
-                                APP_ERROR_CHECK(err_code);
-                                incorrect_attempts = 0;
-                                LOG_DEBUG("Disconnecting from too many incorrect passcode attempts");
-																int8_t response = -2;
-                                ble_boc_response_update(&m_boc, &response, 1);
-                            }
-														int8_t response = -3;
-                            ble_boc_response_update(&m_boc, &response, 1);
-                        }
-                        break;
-                    }
-                    default:
-										{		
-												int8_t response = -1;
-                        ble_boc_response_update(&m_boc, &response, 1);
-                        LOG_WARN("Logged unsupported %s event from %s", evt_str[head->event], st_str[current_state]);
-                        break;
-										}
-                }
-                break;
-            case EVT_CONNECTED:
-                switch(current_state){
-                    case ST_IDLE:
-                    {
-                        uint32_t err_code;
-                        EVENT event = EVT_TIMED_OUT;
-                        err_code = app_timer_start(m_connection_timeout_timer_id, CONNECTION_TIMEOUT_INTERVAL, &event);
-                        APP_ERROR_CHECK(err_code);
-                        current_state = ST_CONNECTED;
-                        selected_operation = OP_INVALID;
-                        break;
-                    }
-                    case ST_UNSEEDED:
-                    {
-                        uint32_t err_code;
-                        EVENT event = EVT_TIMED_OUT;
-                        err_code = app_timer_start(m_connection_timeout_timer_id, CONNECTION_TIMEOUT_INTERVAL, &event);
-                        APP_ERROR_CHECK(err_code);
-                        current_state = ST_UNSEEDED_CONNECTED;
-                        selected_operation = OP_INVALID;
-                        break;
-                    }
-                    default:
-                        LOG_WARN("Logged unsupported %s event from %s", evt_str[head->event], st_str[current_state]);
-                        break;
-                }
-                break;
-            case EVT_DISCONNECTED:
-                switch(current_state){
-                    case ST_CONNECTED: 
-                        app_timer_stop(m_connection_timeout_timer_id);
-                        LOG_DEBUG("Connection Timeout Timer stopped due to Manual Disconnect");
-                    case ST_UNLOCKED: case ST_LOCKED:
-                        current_state = ST_IDLE;
-                        break;
-                    case ST_UNSEEDED_CONNECTED:
-                        app_timer_stop(m_connection_timeout_timer_id);
-                        LOG_DEBUG("Connection Timeout Timer stopped due to Manual Disconnect");
-                        current_state = ST_UNSEEDED;
-                        break;
-                    default:
-                        LOG_WARN("Logged unsupported %s event from %s", evt_str[head->event], st_str[current_state]);
-                        break;
-                }
-                break;
-            case EVT_TIMED_OUT:
-                switch(current_state){
-                    case ST_CONNECTED: case ST_UNSEEDED_CONNECTED:
-                    {
-                        uint32_t err_code = sd_ble_gap_disconnect(0, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
-                        APP_ERROR_CHECK(err_code);
-                        break;
-                    }
-                    default:
-                        LOG_WARN("Logged unsupported %s event from %s", evt_str[head->event], st_str[current_state]);
-                        break;
-                }
-                break;
-            case EVT_PASSCODE_TIMED_OUT:
-                switch(current_state){
-                    case ST_UNLOCKED:
-                        current_state = ST_LOCKED;
-                        selected_operation = OP_INVALID;
-                    case ST_IDLE: case ST_LOCKED: case ST_CONNECTED:
-												passcodes[0] = passcodes[1];
-										    passcodes[1] = passcodes[2];
-                        passcodes[2] = genrand64_int64();
-												LOG_INFO("Passcode Prev (MSB) - %08X", passcodes[0] >> 32);
-												LOG_INFO("Passcode Prev (LSB) - %08X", passcodes[0]);
-												LOG_INFO("Passcode Curr (MSB) - %08X", passcodes[1] >> 32);
-												LOG_INFO("Passcode Curr (LSB) - %08X", passcodes[1]);
-												LOG_INFO("Passcode Next (MSB) - %08X", passcodes[2] >> 32);
-												LOG_INFO("Passcode Next (LSB) - %08X", passcodes[2]);
-												app_timer_cnt_get(&passcode_rotate_timer_start_ticks);
-                        break;
-                    default:
-                        LOG_WARN("Logged unsupported %s event from %s", evt_str[head->event], st_str[current_state]);
-                        break;
-                }
-                break;
-            case EVT_OPERATION_SET:
-                switch(current_state){
-                    case ST_UNLOCKED:
-										{
-                        if(*((OPERATION *) head->data) >= NUM_OPERATIONS){
-                            selected_operation = OP_INVALID;
-														int8_t response = -4;
-                            ble_boc_response_update(&m_boc, &response, 1);
-                            break;
-                        }
-                        selected_operation = *((OPERATION *) head->data);
-												LOG_DEBUG("Selected operation %s", op_str[selected_operation]);
-												if(selected_operation == OP_GET_MILLIS ||
-													 selected_operation == OP_SYNC_TIMER ||
-												   selected_operation == OP_SYNC_TIMER_ADV){
-														LOG_DEBUG("Running operation %s", op_str[selected_operation]);
-														(*operations[selected_operation])(0);
-												} else {                       
-														int8_t response = 4;
-														ble_boc_response_update(&m_boc, &response, 1);
-												}
-                        break;
-										}
-										case ST_LOCKED: case ST_CONNECTED: case ST_UNSEEDED_CONNECTED:
-										{
-												int8_t response = -5;
-												ble_boc_response_update(&m_boc, &response, 1);					
-												break;
-										}
-										default:
-										{
-												int8_t response = -1;
-												ble_boc_response_update(&m_boc, &response, 1);
-												break;
-										}
-								}
-                break;
-            case EVT_OPERAND_SET:
-                switch(current_state){
-                    case ST_UNLOCKED:
-										{
-                        if(selected_operation == OP_INVALID){
-														int8_t response = -4;
-                            ble_boc_response_update(&m_boc, &response, 1);
-                            break;     
-                        }
-                        (*operations[selected_operation])(*((uint8_t *) head->data));
-												int8_t response = 5;
-                        ble_boc_response_update(&m_boc, &response, 1);
-                        break;
-										}
-										case ST_LOCKED: case ST_CONNECTED: case ST_UNSEEDED_CONNECTED:
-										{
-												int8_t response = -6;
-												ble_boc_response_update(&m_boc, &response, 1);
-												break;
-										}
-										default:
-										{
-												int8_t response = -1;
-												ble_boc_response_update(&m_boc, &response, 1);
-												break;
-										}											
-								}
-								break;
-						default:
-                LOG_ERROR("Logged unsupported event %s", evt_str[head->event]);
-                break;
-        }
-    }
-
-    head = head->next;
-
-    LOG_INFO("Current State - %s", st_str[current_state]);
-
-    free(event_to_process->data);
-    free(event_to_process);
-    queued_events--;
-}
-
-bool events_queued(){
-    if(queued_events){
-        return true;
-    }
-    return false;
-}
-
-void connection_timeout(void * p_context){
-    add_event(EVT_TIMED_OUT, NULL, 0);
-}
-
-void passcode_timeout(void * p_context){
-    add_event(EVT_PASSCODE_TIMED_OUT, NULL, 0);
-}
-
-void starter_timeout(void * p_context){
-		op_starter(0);
-}
-
-void op_invalid(uint32_t toggle){
-    LOG_INFO("Setting Operation Invalid to %d", toggle);
-		LOG_ERROR("Attempt to run Invalid Operation");
-}
-
-void op_lock(uint32_t toggle){
-    LOG_INFO("Setting Operation Lock to %d", toggle);
-		if(toggle){
-			nrf_gpio_pin_set(LED_1);
-		} else {
-			nrf_gpio_pin_clear(LED_1);
-		}
-}
-
-void op_ignition(uint32_t toggle){
-    LOG_INFO("Setting Operation Ignition to %d", toggle);
-		if(toggle){
-			nrf_gpio_pin_set(LED_2);
-		} else {
-			nrf_gpio_pin_clear(LED_2);
-		}
-}
-
-void op_starter(uint32_t toggle){
-    LOG_INFO("Setting Operation Starter to %d", toggle);
-		if(toggle){
-			app_timer_stop(m_starter_timer_id);
-			app_timer_start(m_starter_timer_id, STARTER_INTERVAL, 0);
-			
-			nrf_gpio_pin_set(LED_3);
-		} else {
-			nrf_gpio_pin_clear(LED_3);
-		}
-}
-
-void op_panic(uint32_t toggle){
-    LOG_INFO("Setting Operation Panic to %d", toggle);
-		if(toggle){
-			nrf_gpio_pin_set(LED_4);
-			nrf_gpio_pin_set(11);
-		} else {
-			nrf_gpio_pin_clear(LED_4);
-			nrf_gpio_pin_clear(11);
-		}
-}
-
-void op_get_millis(uint32_t arg){
-	
-		UNUSED_PARAMETER(arg);
-	
-		uint32_t millis;
-	
-		app_timer_cnt_get(&millis);
-		app_timer_cnt_diff_compute(millis,
-                               passcode_rotate_timer_start_ticks,
-                               &millis);
-	
-		millis = ENDIAN_SWAP_32(app_timer_ms(millis));
-	
-		ble_boc_response_update(&m_boc, &millis, 4);
-}
-
-void op_sync_timer(uint32_t arg){
-		
-		app_timer_stop(m_passcode_rotate_timer_id);
-		app_timer_start(m_passcode_rotate_timer_id, PASSCODE_ROTATE_INTERVAL, 0);
-		app_timer_cnt_get(&passcode_rotate_timer_start_ticks);
-
-}
-
-void op_sync_timer_adv(uint32_t arg){
-		app_timer_stop(m_passcode_rotate_timer_id);
-		app_timer_start(m_passcode_rotate_timer_id, PASSCODE_ROTATE_INTERVAL, 0);
-		passcodes[0] = passcodes[1];
-		passcodes[1] = passcodes[2];
-		passcodes[2] = genrand64_int64();
-		LOG_INFO("Passcode Prev (MSB) - %08X", passcodes[0] >> 32);
-		LOG_INFO("Passcode Prev (LSB) - %08X", passcodes[0]);
-		LOG_INFO("Passcode Curr (MSB) - %08X", passcodes[1] >> 32);
-		LOG_INFO("Passcode Curr (LSB) - %08X", passcodes[1]);
-		LOG_INFO("Passcode Next (MSB) - %08X", passcodes[2] >> 32);
-		LOG_INFO("Passcode Next (LSB) - %08X", passcodes[2]);
-		app_timer_cnt_get(&passcode_rotate_timer_start_ticks);
-		add_event(EVT_PASSCODE_TIMED_OUT, NULL, 0);
-}
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include "ign_state_machine.h"
+#include "logger.h"
+#include "ble_boc.h"
+#include "prng.h"
+#include "diagnostics.h"
+#include "power_profile.h"
+#include "conn_policy.h"
+#include "kv_store.h"
+#include "flight_recorder.h"
+#include "timebase.h"
+#include "uart_cmd.h"
+#include "ble_hci.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "boards.h"
+#include "nordic_common.h"
+
+#define CONNECTION_TIMEOUT_INTERVAL APP_TIMER_TICKS(60000, 0)
+#define PASSCODE_ROTATE_MS 30000
+#define PASSCODE_ROTATE_INTERVAL APP_TIMER_TICKS(PASSCODE_ROTATE_MS, 0)
+#define SEED_SAVE_ROTATIONS 4                   // Timer rotations between position writes to flash (2 minutes)
+#define STARTER_INTERVAL APP_TIMER_TICKS(80, 0)
+#define FAST_FORWARD_MAX_ROTATIONS 2880         // A day of rotations; MT19937-64 steps through every draw skipped
+#define POWER_STATS_DUMP 0xFFFFFFFF             // OP_POWER_STATS operand that logs every state instead
+
+static const char* st_str[] = {
+                "ST_INVALID",
+                "ST_UNSEEDED", 
+                "ST_UNSEEDED_CONNECTED",
+                "ST_IDLE", 
+                "ST_CONNECTED", 
+                "ST_LOCKED", 
+                "ST_UNLOCKED"
+};
+
+static const char* evt_str[] = {
+                "EVT_INVALID",
+                "EVT_BUTTON_PRESS",
+                "EVT_PASSCODE_SET",
+                "EVT_CONNECTED",
+                "EVT_DISCONNECTED",
+                "EVT_TIMED_OUT",
+                "EVT_PASSCODE_TIMED_OUT",
+                "EVT_OPERATION_SET",
+                "EVT_OPERAND_SET",
+                "EVT_COMMAND_SET"
+};
+
+static const char* op_str[] = {
+                "OP_INVALID",
+                "OP_LOCK",
+                "OP_IGNITION",
+                "OP_STARTER",
+                "OP_PANIC",
+								"OP_GET_MILLIS",
+								"OP_SYNC_TIMER",
+								"OP_SYNC_TIMER_ADV",
+                "OP_FAST_FORWARD",
+                "OP_POWER_STATS",
+                "OP_SCENE"
+};
+
+// The names are indexed by the enums, so they must grow together
+STATIC_ASSERT(sizeof(st_str) / sizeof(st_str[0]) == NUM_STATES);
+STATIC_ASSERT(sizeof(evt_str) / sizeof(evt_str[0]) == NUM_EVENTS);
+STATIC_ASSERT(sizeof(op_str) / sizeof(op_str[0]) == NUM_OPERATIONS);
+
+#define ENDIAN_SWAP_32( x )  (\
+              (( x & 0x000000FF ) << 24 ) \
+            | (( x & 0x0000FF00 ) << 8  ) \
+            | (( x & 0x00FF0000 ) >> 8  ) \
+            | (( x & 0xFF000000 ) >> 24 ) \
+            )
+
+static event_queue_t m_event_queue;
+uint8_t current_state = ST_UNSEEDED;
+
+// Ring of the passcodes in the window, draw n of the generator in slot
+// n % PASSCODE_WINDOW. Rotating only moves passcode_current; the draws it
+// exposes are made by passcodes_refill() when the main loop is idle.
+static uint64_t passcodes[PASSCODE_WINDOW];
+static uint32_t passcode_current = 0;           // Draw number of the current passcode, 0 until seeded
+static ble_boc_t * mp_boc;
+
+static app_timer_id_t m_connection_timeout_timer_id;
+static app_timer_id_t m_passcode_rotate_timer_id;
+static app_timer_id_t m_starter_timer_id;
+
+uint64_t passcode_rotate_timer_start_ticks;        // timebase_ticks() when the current rotation interval started
+
+static uint32_t prng_draws = 0;                 // prng_next64() calls since seeding, the newest passcode in the ring
+static uint8_t rotations_unsaved = 0;           // Timer rotations since the position was last written
+static bool rotate_timer_realign = false;       // Rotation timer runs a shortened first interval after a restore
+
+// Value of KV_KEY_SEED_POSITION
+typedef struct {
+        uint32_t current;                       // Draw number of the current passcode
+        uint32_t phase_ms;                      // Time into the current rotation interval
+} seed_position_t;
+
+void connection_timeout(void* p_context);
+void passcode_timeout(void* p_context);
+void starter_timeout(void* p_context);
+static void passcodes_restore(void);
+
+int8_t op_invalid(uint32_t toggle);
+int8_t op_lock(uint32_t toggle);
+int8_t op_ignition(uint32_t toggle);
+int8_t op_starter(uint32_t toggle);
+int8_t op_panic(uint32_t toggle);
+int8_t op_get_millis(uint32_t arg);
+int8_t op_sync_timer(uint32_t arg);
+int8_t op_sync_timer_adv(uint32_t arg);
+int8_t op_fast_forward(uint32_t rotations);
+int8_t op_power_stats(uint32_t state);
+int8_t op_scene(uint32_t scene);
+
+// Operations return 0, or a negative response code when they refuse the
+// operand without changing anything
+int8_t (*operations[NUM_OPERATIONS])(uint32_t arg) = { op_invalid, op_lock, op_ignition, op_starter, op_panic, op_get_millis, op_sync_timer, op_sync_timer_adv, op_fast_forward, op_power_stats, op_scene };
+
+// Outputs of OP_SCENE, in operand bit order
+static const uint32_t scene_outputs[] = { OUT_LOCK_MASK, OUT_IGNITION_MASK, OUT_STARTER_MASK, OUT_PANIC_MASK };
+#define SCENE_BITS (sizeof(scene_outputs) / sizeof(scene_outputs[0]))
+
+void state_machine_init(ble_boc_t * p_boc){
+
+    uint32_t err_code;
+    err_code = app_timer_create(&m_connection_timeout_timer_id, APP_TIMER_MODE_SINGLE_SHOT, connection_timeout);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_create(&m_passcode_rotate_timer_id, APP_TIMER_MODE_REPEATED, passcode_timeout);
+    APP_ERROR_CHECK(err_code);
+	
+	  err_code = app_timer_create(&m_starter_timer_id, APP_TIMER_MODE_SINGLE_SHOT, starter_timeout);
+    APP_ERROR_CHECK(err_code);
+
+    mp_boc = p_boc;
+
+    passcodes_restore();
+}
+
+void add_event(EVENT event, void* data, uint8_t size){
+    uint8_t depth;
+    bool dropped = false;
+
+    if(event >= NUM_EVENTS){
+        LOG_ERROR("Undefined Event %d Added", event);
+        return;
+    }
+
+    LOG_INFO("Adding Event %s", evt_str[event]);
+
+    if(size > MAX_EVENT_DATA){
+        size = MAX_EVENT_DATA;
+    }
+
+    // The main loop queues events as well (op_sync_timer_adv(), closing a UART
+    // session), so the interrupt producers are held off while a slot is taken
+    CRITICAL_REGION_ENTER();
+    uint8_t tail = m_event_queue.tail;
+
+    if((uint8_t)(tail - m_event_queue.head) >= MAX_EVENTS){
+        m_event_queue.overflows++;
+        dropped = true;
+    } else {
+        queued_event_t* new_event = &m_event_queue.slots[tail & (MAX_EVENTS - 1)];
+        new_event->event = event;
+        new_event->size = size;
+        if(size){
+            memcpy(new_event->data, data, size);
+        }
+        app_timer_cnt_get(&new_event->queued_ticks);
+
+        // Publish the slot only after it has been filled in
+        m_event_queue.tail = tail + 1;
+        diag_event_queued((uint8_t)(m_event_queue.tail - m_event_queue.head));
+    }
+    depth = (uint8_t)(m_event_queue.tail - m_event_queue.head);
+    CRITICAL_REGION_EXIT();
+
+    flight_recorder_event_queued(event, (STATE)current_state, dropped);
+    if(dropped){
+        LOG_WARN("Event queue full, dropped %s (%d dropped)", evt_str[event], m_event_queue.overflows);
+        return;
+    }
+
+    LOG_DEBUG("%d Queued Events", depth);
+}
+
+
+
+static OPERATION selected_operation = OP_INVALID;
+
+// Successful commands are acknowledged cumulatively: {seq, 5} means every
+// command up to seq that was not answered otherwise has run. The ack is held
+// back while more commands are queued and goes out before any other response.
+static bool command_ack_pending = false;
+static int8_t last_response;                    // Last code the current event answered, for the flight recorder
+static uint8_t command_ack_seq;
+static bool command_seq_valid = false;
+static uint8_t command_next_seq;
+
+// Responses and disconnects go to whichever link the controller holds, the
+// phone or a wired UART session
+
+static void link_response_update(const void* data, uint8_t len){
+    if(uart_cmd_session_open()){
+        uart_cmd_response_update(data, len);
+    } else {
+        ble_boc_response_update(mp_boc, (void*)data, len);
+    }
+}
+
+static void link_tx_flush(void){
+    if(uart_cmd_session_open()){
+        uart_cmd_tx_flush();
+    } else {
+        ble_boc_tx_flush(mp_boc);
+    }
+}
+
+static void link_disconnect(void){
+    if(uart_cmd_session_open()){
+        uart_cmd_session_close();
+    } else {
+        // The link may be on its way down already, dropped by the phone or by
+        // an earlier disconnect, which only leaves nothing to do
+        uint32_t err_code = sd_ble_gap_disconnect(mp_boc->conn_handle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+        if(err_code != NRF_ERROR_INVALID_STATE && err_code != BLE_ERROR_INVALID_CONN_HANDLE){
+            APP_ERROR_CHECK(err_code);
+        }
+    }
+}
+
+static void command_ack_flush(void){
+    if(command_ack_pending){
+        uint8_t frame[2] = { command_ack_seq, 5 };
+        command_ack_pending = false;
+        link_response_update(frame, sizeof(frame));
+    }
+}
+
+static void send_response_data(void* data, uint8_t len){
+    command_ack_flush();
+    link_response_update(data, len);
+}
+
+static void send_response(int8_t response){
+    last_response = response;
+    send_response_data(&response, 1);
+}
+
+static void send_command_response(uint8_t seq, int8_t response){
+    uint8_t frame[2] = { seq, (uint8_t)response };
+    last_response = response;
+    send_response_data(frame, sizeof(frame));
+}
+
+static uint64_t passcode_decode(const uint8_t* data){
+    uint64_t value = 0LL;
+    for(int i = 0; i < 8; i++){
+        uint64_t temp = data[i];
+        temp = temp << ((7 - i) * 8);
+        value += temp;
+    }
+    return value;
+}
+
+// Operands are written big endian and may be up to 4 bytes long
+static uint32_t operand_decode(const uint8_t* data, uint8_t size){
+    uint32_t value = 0;
+    for(int i = 0; i < size && i < 4; i++){
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+STATIC_ASSERT(PASSCODE_WINDOW >= 3 && PASSCODE_WINDOW <= 16);
+
+// Draws the passcodes up to the end of the window that are not in the ring yet
+void passcodes_refill(void){
+    if(passcode_current == 0){
+        return;
+    }
+
+    while(prng_draws < passcode_current + PASSCODE_LOOKAHEAD){
+        prng_draws++;
+        passcodes[prng_draws % PASSCODE_WINDOW] = prng_next64();
+        LOG_INFO("Passcode %d (MSB) - %08X", prng_draws, (uint32_t)(passcodes[prng_draws % PASSCODE_WINDOW] >> 32));
+        LOG_INFO("Passcode %d (LSB) - %08X", prng_draws, (uint32_t)passcodes[prng_draws % PASSCODE_WINDOW]);
+    }
+}
+
+// Moves the window on by a number of rotation intervals. Draws that would fall
+// out of the window before they are used are skipped with prng_jump().
+static void passcodes_advance(uint32_t rotations){
+    passcode_current += rotations;
+    if(passcode_current > prng_draws + 1 + PASSCODE_LOOKBEHIND){
+        uint32_t skipped = passcode_current - PASSCODE_LOOKBEHIND - 1 - prng_draws;
+        prng_jump(skipped);
+        prng_draws += skipped;
+    }
+    passcode_rotate_timer_start_ticks = timebase_ticks();
+    LOG_INFO("Current passcode is draw %d", passcode_current);
+}
+
+static uint32_t rotation_phase_ms(void){
+    return (uint32_t)timebase_ticks_to_ms(timebase_ticks() - passcode_rotate_timer_start_ticks);
+}
+
+static void position_save(void){
+    seed_position_t position;
+
+    if(passcode_current == 0){
+        return;
+    }
+
+    position.current = passcode_current;
+    position.phase_ms = rotation_phase_ms();
+    kv_store_put(KV_KEY_SEED_POSITION, &position, sizeof(position));
+    rotations_unsaved = 0;
+}
+
+// Rotation from the passcode timer. The position only goes to flash every
+// SEED_SAVE_ROTATIONS rotations; anything the phone resyncs is written at once.
+static void passcodes_timer_rotate(void){
+    if(rotate_timer_realign){
+        rotate_timer_realign = false;
+        app_timer_restart(m_passcode_rotate_timer_id, PASSCODE_ROTATE_INTERVAL, NULL);
+    }
+
+    passcodes_advance(1);
+
+    if(++rotations_unsaved >= SEED_SAVE_ROTATIONS){
+        position_save();
+    }
+}
+
+// Picks up the seed, generator position and rotation timer phase stored
+// before the last reset, so the phone doesn't have to seed again.
+static void passcodes_restore(void){
+    uint64_t seed[4];
+    seed_position_t position;
+    uint32_t phase_ms;
+    uint32_t phase_ticks;
+    uint32_t err_code;
+
+    if(kv_store_get(KV_KEY_SEED, seed, sizeof(seed)) != sizeof(seed)
+       || kv_store_get(KV_KEY_SEED_POSITION, &position, sizeof(position)) != sizeof(position)
+       || position.current == 0){
+        return;
+    }
+    phase_ms = position.phase_ms;
+
+    prng_seed(seed, 4);
+    memset(seed, 0, sizeof(seed));
+
+    prng_draws = 0;
+    passcode_current = 0;
+    passcodes_advance(position.current);
+    passcodes_refill();
+
+    if(phase_ms >= PASSCODE_ROTATE_MS){
+        phase_ms = PASSCODE_ROTATE_MS - 1;
+    }
+    phase_ticks = APP_TIMER_TICKS(phase_ms, 0);
+    passcode_rotate_timer_start_ticks -= phase_ticks;
+
+    rotate_timer_realign = true;
+    err_code = app_timer_start(m_passcode_rotate_timer_id, PASSCODE_ROTATE_INTERVAL - phase_ticks, NULL);
+    APP_ERROR_CHECK(err_code);
+
+    LOG_INFO("Restored seed at draw %d, %d ms into the rotation", passcode_current, phase_ms);
+    current_state = ST_IDLE;
+}
+
+/*
+ *  Transition handlers. Each one runs the side effects of an event in a given
+ *  state and returns true when the transition to the table's next state
+ *  should be taken, or false to stay in the current state.
+ */
+
+static bool evt_unsupported(queued_event_t* event){
+    LOG_WARN("Logged unsupported %s event from %s", evt_str[event->event], st_str[current_state]);
+    return false;
+}
+
+static bool evt_rejected(queued_event_t* event){
+    send_response(-1);
+    LOG_WARN("Logged unsupported %s event from %s", evt_str[event->event], st_str[current_state]);
+    return false;
+}
+
+static bool evt_invalid(queued_event_t* event){
+    LOG_ERROR("Tried to process invalid event");
+    send_response(-1);
+    return false;
+}
+
+static bool evt_seed_reset(queued_event_t* event){
+    app_timer_stop(m_passcode_rotate_timer_id);
+    rotate_timer_realign = false;
+    prng_draws = 0;
+    passcode_current = 0;
+    rotations_unsaved = 0;
+    LOG_DEBUG("Passcode Rotation Timer stopped due to Seed Reset");
+
+    // Compacting scrubs the old seed from flash, not just marks it deleted
+    kv_store_delete(KV_KEY_SEED);
+    kv_store_delete(KV_KEY_SEED_POSITION);
+    kv_store_compact();
+    return true;
+}
+
+static bool evt_seed_reset_disconnect(queued_event_t* event){
+    link_disconnect();
+    return evt_seed_reset(event);
+}
+
+static bool evt_seed_set(queued_event_t* event){
+    static uint64_t seed[4] = {0LL, 0LL, 0LL, 0LL};
+    static uint8_t number_of_seed_values = 0;
+
+    if(event->size < 8){
+        send_response(-1);
+        return false;
+    }
+
+    uint64_t seed_value = passcode_decode(event->data);
+
+    seed[number_of_seed_values] = seed_value;
+
+    LOG_DEBUG("Seed Value (MSB) - %08X", (uint32_t)(seed_value >> 32)); 
+    LOG_DEBUG("Seed Value (LSB) - %08X", (uint32_t)seed_value);
+
+    number_of_seed_values++;
+
+    LOG_DEBUG("Seed Values Received - %d", number_of_seed_values);
+
+    if(number_of_seed_values < 4){
+        send_response(1);
+        return false;
+    }
+
+    //Seed Completed
+    LOG_DEBUG("Final seed is ");
+    for(int i = 0; i < 4; i++){
+        LOG_DEBUG("%08X", (uint32_t)(seed[i] >> 32));
+        LOG_DEBUG("%08X", (uint32_t)seed[i]);
+    }
+
+    prng_seed(seed, 4);
+
+    //Generate and record passcode, the first draw is the previous passcode
+    prng_draws = 0;
+    passcode_current = 0;
+    passcodes_advance(2);
+    passcodes_refill();
+
+    kv_store_put(KV_KEY_SEED, seed, sizeof(seed));
+    position_save();
+
+    //Reset Seed and Counter
+    for(int i = 0; i < 4; i++){
+        seed [i] = 0LL;
+    }
+    number_of_seed_values = 0;
+
+    uint32_t err_code;
+    EVENT timeout_event = EVT_PASSCODE_TIMED_OUT;
+    err_code = app_timer_start(m_passcode_rotate_timer_id, PASSCODE_ROTATE_INTERVAL, &timeout_event);
+    APP_ERROR_CHECK(err_code);
+
+    //Send successful response
+    send_response(2);
+    return true;
+}
+
+// Returns the passcode response for a guess (6, 3 or 7 for the previous,
+// current or next passcode, 8 for one further away), -3 if it is wrong or -2
+// when it was the last allowed attempt and the connection is being dropped.
+// p_offset gets the rotations between the guess and the current passcode.
+static int8_t passcode_check(uint64_t guess, int8_t* p_offset){
+    static uint8_t incorrect_attempts = 0;
+
+    passcodes_refill();
+
+    // Every passcode is compared, so the time taken doesn't give away a match
+    int8_t offset = 0;
+    bool matched = false;
+    for(int i = -PASSCODE_LOOKBEHIND; i <= PASSCODE_LOOKAHEAD; i++){
+        uint32_t draw = passcode_current + i;
+        if(draw >= 1 && draw <= prng_draws && passcodes[draw % PASSCODE_WINDOW] == guess){
+            offset = i;
+            matched = true;
+        }
+    }
+
+    if(matched){
+        *p_offset = offset;
+        if(offset == -1){
+            return 6;
+        } else if(offset == 0){
+            return 3;
+        } else if(offset == 1){
+            return 7;
+        }
+        return 8;
+    }
+
+    incorrect_attempts++;
+    diag_wrong_passcode();
+    LOG_DEBUG("Incorrect passcode attempt");
+    if(incorrect_attempts >= 5){
+        link_disconnect();
+        incorrect_attempts = 0;
+        LOG_DEBUG("Disconnecting from too many incorrect passcode attempts");
+        return -2;
+    }
+    return -3;
+}
+
+static bool evt_passcode_guess(queued_event_t* event){
+    if(event->size < 8){
+        send_response(-3);
+        return false;
+    }
+
+    int8_t offset;
+    int8_t response = passcode_check(passcode_decode(event->data), &offset);
+
+    if(response < 0){
+        if(response == -2){
+            send_response(-2);
+        }
+        send_response(-3);
+        return false;
+    }
+
+    app_timer_stop(m_connection_timeout_timer_id);
+    LOG_DEBUG("Connection Timeout Timer stopped due to Correct Passcode");
+    if(response == 8){
+        int8_t frame[2] = { response, offset };
+        last_response = response;
+        send_response_data(frame, sizeof(frame));
+    } else {
+        send_response(response);
+    }
+    return true;
+}
+
+static bool evt_connected(queued_event_t* event){
+    uint32_t err_code;
+    EVENT timeout_event = EVT_TIMED_OUT;
+    err_code = app_timer_start(m_connection_timeout_timer_id, CONNECTION_TIMEOUT_INTERVAL, &timeout_event);
+    APP_ERROR_CHECK(err_code);
+    selected_operation = OP_INVALID;
+    command_seq_valid = false;
+    return true;
+}
+
+static bool evt_disconnected(queued_event_t* event){
+    app_timer_stop(m_connection_timeout_timer_id);
+    LOG_DEBUG("Connection Timeout Timer stopped due to Manual Disconnect");
+    if(rotations_unsaved){
+        position_save();
+    }
+    return true;
+}
+
+static bool evt_timed_out(queued_event_t* event){
+    link_disconnect();
+    return false;
+}
+
+static bool evt_passcode_rotate(queued_event_t* event){
+    passcodes_timer_rotate();
+    return false;
+}
+
+static bool evt_passcode_relock(queued_event_t* event){
+    selected_operation = OP_INVALID;
+    passcodes_timer_rotate();
+    return true;
+}
+
+static bool evt_operation_set(queued_event_t* event){
+    if(event->size < 1 || event->data[0] == OP_INVALID || event->data[0] >= NUM_OPERATIONS){
+        selected_operation = OP_INVALID;
+        send_response(-4);
+        return false;
+    }
+    selected_operation = (OPERATION) event->data[0];
+    LOG_DEBUG("Selected operation %s", op_str[selected_operation]);
+    if(selected_operation == OP_GET_MILLIS ||
+       selected_operation == OP_SYNC_TIMER ||
+       selected_operation == OP_SYNC_TIMER_ADV){
+        LOG_DEBUG("Running operation %s", op_str[selected_operation]);
+        int8_t response = (*operations[selected_operation])(0);
+        if(response < 0){
+            send_response(response);
+        }
+    } else {
+        send_response(4);
+    }
+    return false;
+}
+
+static bool evt_operation_locked(queued_event_t* event){
+    send_response(-5);
+    return false;
+}
+
+static bool evt_operand_set(queued_event_t* event){
+    if(selected_operation == OP_INVALID || event->size < 1){
+        send_response(-4);
+        return false;
+    }
+    int8_t response = (*operations[selected_operation])(operand_decode(event->data, event->size));
+    send_response((response < 0) ? response : 5);
+    return false;
+}
+
+static bool evt_operand_locked(queued_event_t* event){
+    send_response(-6);
+    return false;
+}
+
+// Runs the passcode, operation and operand steps of a command frame in one go
+// and answers with a single {seq, response} pair. A passcode other than the
+// current one is reported first, as for a passcode write: {seq, 6}, {seq, 7}
+// or {seq, 8, offset}.
+static bool evt_command_set(queued_event_t* event){
+    if(event->size < CMD_FRAME_LEN){
+        send_response(-1);
+        return false;
+    }
+
+    uint8_t seq = event->data[CMD_SEQ_OFFSET];
+
+    // A gap means a frame was lost (e.g. the event queue overflowed), so nothing
+    // after it runs until the client resends from command_next_seq
+    if(command_seq_valid && seq != command_next_seq){
+        LOG_WARN("Command %d out of sequence, expected %d", seq, command_next_seq);
+        send_command_response(seq, -7);
+        return false;
+    }
+    command_seq_valid = true;
+    command_next_seq = seq + 1;
+
+    int8_t offset;
+    int8_t response = passcode_check(passcode_decode(&event->data[CMD_PASSCODE_OFFSET]), &offset);
+
+    if(response < 0){
+        send_command_response(seq, response);
+        return false;
+    }
+    if(response == 8){
+        uint8_t frame[3] = { seq, (uint8_t)response, (uint8_t)offset };
+        last_response = response;
+        send_response_data(frame, sizeof(frame));
+    } else if(response != 3){
+        send_command_response(seq, response);
+    }
+
+    app_timer_stop(m_connection_timeout_timer_id);
+
+    uint8_t opcode = event->data[CMD_OPCODE_OFFSET];
+    if(opcode == OP_INVALID || opcode >= NUM_OPERATIONS){
+        selected_operation = OP_INVALID;
+        send_command_response(seq, -4);
+        return true;
+    }
+
+    selected_operation = (OPERATION) opcode;
+    LOG_DEBUG("Running command %d operation %s", seq, op_str[selected_operation]);
+
+    // Any output of the operation flushes the ack ahead of itself
+    bool ack_was_pending = command_ack_pending;
+    uint8_t ack_was_seq = command_ack_seq;
+    command_ack_seq = seq;
+    command_ack_pending = true;
+    last_response = 5;
+    response = (*operations[selected_operation])(operand_decode(&event->data[CMD_OPERAND_OFFSET], 4));
+    if(response < 0){
+        // This frame did not run, only the earlier ones are acknowledged
+        command_ack_seq = ack_was_seq;
+        command_ack_pending = ack_was_pending;
+        send_command_response(seq, response);
+    }
+    return true;
+}
+
+static bool evt_command_locked(queued_event_t* event){
+    uint8_t seq = (event->size > CMD_SEQ_OFFSET) ? event->data[CMD_SEQ_OFFSET] : 0;
+    send_command_response(seq, -5);
+    return false;
+}
+
+/*
+ *  Transition table indexed by [STATE][EVENT]. The handler (if any) runs
+ *  first and the state only moves to next_state when it returns true.
+ */
+static const transition_t transitions[NUM_STATES][NUM_EVENTS] = {
+    [ST_INVALID] = {
+        [EVT_INVALID]            = { evt_invalid,               ST_INVALID },
+        [EVT_BUTTON_PRESS]       = { evt_seed_reset,            ST_UNSEEDED },
+        [EVT_PASSCODE_SET]       = { evt_rejected,              ST_INVALID },
+        [EVT_CONNECTED]          = { evt_unsupported,           ST_INVALID },
+        [EVT_DISCONNECTED]       = { evt_unsupported,           ST_INVALID },
+        [EVT_TIMED_OUT]          = { evt_unsupported,           ST_INVALID },
+        [EVT_PASSCODE_TIMED_OUT] = { evt_unsupported,           ST_INVALID },
+        [EVT_OPERATION_SET]      = { evt_rejected,              ST_INVALID },
+        [EVT_OPERAND_SET]        = { evt_rejected,              ST_INVALID },
+        [EVT_COMMAND_SET]        = { evt_rejected,              ST_INVALID },
+    },
+    [ST_UNSEEDED] = {
+        [EVT_INVALID]            = { evt_invalid,               ST_UNSEEDED },
+        [EVT_BUTTON_PRESS]       = { evt_seed_reset,            ST_UNSEEDED },
+        [EVT_PASSCODE_SET]       = { evt_rejected,              ST_UNSEEDED },
+        [EVT_CONNECTED]          = { evt_connected,             ST_UNSEEDED_CONNECTED },
+        [EVT_DISCONNECTED]       = { evt_unsupported,           ST_UNSEEDED },
+        [EVT_TIMED_OUT]          = { evt_unsupported,           ST_UNSEEDED },
+        [EVT_PASSCODE_TIMED_OUT] = { evt_unsupported,           ST_UNSEEDED },
+        [EVT_OPERATION_SET]      = { evt_rejected,              ST_UNSEEDED },
+        [EVT_OPERAND_SET]        = { evt_rejected,              ST_UNSEEDED },
+        [EVT_COMMAND_SET]        = { evt_rejected,              ST_UNSEEDED },
+    },
+    [ST_UNSEEDED_CONNECTED] = {
+        [EVT_INVALID]            = { evt_invalid,               ST_UNSEEDED_CONNECTED },
+        [EVT_BUTTON_PRESS]       = { evt_seed_reset_disconnect, ST_UNSEEDED },
+        [EVT_PASSCODE_SET]       = { evt_seed_set,              ST_CONNECTED },
+        [EVT_CONNECTED]          = { evt_unsupported,           ST_UNSEEDED_CONNECTED },
+        [EVT_DISCONNECTED]       = { evt_disconnected,          ST_UNSEEDED },
+        [EVT_TIMED_OUT]          = { evt_timed_out,             ST_UNSEEDED_CONNECTED },
+        [EVT_PASSCODE_TIMED_OUT] = { evt_unsupported,           ST_UNSEEDED_CONNECTED },
+        [EVT_OPERATION_SET]      = { evt_operation_locked,      ST_UNSEEDED_CONNECTED },
+        [EVT_OPERAND_SET]        = { evt_operand_locked,        ST_UNSEEDED_CONNECTED },
+        [EVT_COMMAND_SET]        = { evt_command_locked,        ST_UNSEEDED_CONNECTED },
+    },
+    [ST_IDLE] = {
+        [EVT_INVALID]            = { evt_invalid,               ST_IDLE },
+        [EVT_BUTTON_PRESS]       = { evt_seed_reset,            ST_UNSEEDED },
+        [EVT_PASSCODE_SET]       = { evt_rejected,              ST_IDLE },
+        [EVT_CONNECTED]          = { evt_connected,             ST_CONNECTED },
+        [EVT_DISCONNECTED]       = { evt_unsupported,           ST_IDLE },
+        [EVT_TIMED_OUT]          = { evt_unsupported,           ST_IDLE },
+        [EVT_PASSCODE_TIMED_OUT] = { evt_passcode_rotate,       ST_IDLE },
+        [EVT_OPERATION_SET]      = { evt_rejected,              ST_IDLE },
+        [EVT_OPERAND_SET]        = { evt_rejected,              ST_IDLE },
+        [EVT_COMMAND_SET]        = { evt_rejected,              ST_IDLE },
+    },
+    [ST_CONNECTED] = {
+        [EVT_INVALID]            = { evt_invalid,               ST_CONNECTED },
+        [EVT_BUTTON_PRESS]       = { evt_seed_reset_disconnect, ST_UNSEEDED },
+        [EVT_PASSCODE_SET]       = { evt_passcode_guess,        ST_UNLOCKED },
+        [EVT_CONNECTED]          = { evt_unsupported,           ST_CONNECTED },
+        [EVT_DISCONNECTED]       = { evt_disconnected,          ST_IDLE },
+        [EVT_TIMED_OUT]          = { evt_timed_out,             ST_CONNECTED },
+        [EVT_PASSCODE_TIMED_OUT] = { evt_passcode_rotate,       ST_CONNECTED },
+        [EVT_OPERATION_SET]      = { evt_operation_locked,      ST_CONNECTED },
+        [EVT_OPERAND_SET]        = { evt_operand_locked,        ST_CONNECTED },
+        [EVT_COMMAND_SET]        = { evt_command_set,           ST_UNLOCKED },
+    },
+    [ST_LOCKED] = {
+        [EVT_INVALID]            = { evt_invalid,               ST_LOCKED },
+        [EVT_BUTTON_PRESS]       = { evt_seed_reset_disconnect, ST_UNSEEDED },
+        [EVT_PASSCODE_SET]       = { evt_passcode_guess,        ST_UNLOCKED },
+        [EVT_CONNECTED]          = { evt_unsupported,           ST_LOCKED },
+        [EVT_DISCONNECTED]       = { evt_disconnected,          ST_IDLE },
+        [EVT_TIMED_OUT]          = { evt_unsupported,           ST_LOCKED },
+        [EVT_PASSCODE_TIMED_OUT] = { evt_passcode_rotate,       ST_LOCKED },
+        [EVT_OPERATION_SET]      = { evt_operation_locked,      ST_LOCKED },
+        [EVT_OPERAND_SET]        = { evt_operand_locked,        ST_LOCKED },
+        [EVT_COMMAND_SET]        = { evt_command_set,           ST_UNLOCKED },
+    },
+    [ST_UNLOCKED] = {
+        [EVT_INVALID]            = { evt_invalid,               ST_UNLOCKED },
+        [EVT_BUTTON_PRESS]       = { evt_seed_reset_disconnect, ST_UNSEEDED },
+        [EVT_PASSCODE_SET]       = { evt_rejected,              ST_UNLOCKED },
+        [EVT_CONNECTED]          = { evt_unsupported,           ST_UNLOCKED },
+        [EVT_DISCONNECTED]       = { evt_disconnected,          ST_IDLE },
+        [EVT_TIMED_OUT]          = { evt_unsupported,           ST_UNLOCKED },
+        [EVT_PASSCODE_TIMED_OUT] = { evt_passcode_relock,       ST_LOCKED },
+        [EVT_OPERATION_SET]      = { evt_operation_set,         ST_UNLOCKED },
+        [EVT_OPERAND_SET]        = { evt_operand_set,           ST_UNLOCKED },
+        [EVT_COMMAND_SET]        = { evt_command_set,           ST_UNLOCKED },
+    },
+};
+
+void process_event(){
+
+    LOG_DEBUG("Processing Next Event");
+
+    queued_event_t* head = &m_event_queue.slots[m_event_queue.head & (MAX_EVENTS - 1)];
+
+    if(head->event >= NUM_EVENTS || current_state >= NUM_STATES){
+        LOG_ERROR("Undefined Event %d Received in State %d", head->event, current_state);
+    } else {
+        LOG_DEBUG("Old state is %s", st_str[current_state]);
+        LOG_DEBUG("Processing %s", evt_str[head->event]);   
+
+        const transition_t* transition = &transitions[current_state][head->event];
+        uint32_t start_ticks, end_ticks;
+        STATE old_state = (STATE)current_state;
+
+        last_response = 0;
+        app_timer_cnt_get(&start_ticks);
+        if(transition->handler == NULL || transition->handler(head)){
+            if(current_state != transition->next_state){
+                conn_policy_state_changed(transition->next_state);
+            }
+            current_state = transition->next_state;
+        }
+
+        // Accepted or not, the phone is mid-exchange and wants short intervals
+        switch(head->event){
+            case EVT_PASSCODE_SET:
+            case EVT_OPERATION_SET:
+            case EVT_OPERAND_SET:
+            case EVT_COMMAND_SET:
+                conn_policy_activity();
+                break;
+
+            default:
+                break;
+        }
+        app_timer_cnt_get(&end_ticks);
+
+        diag_event_processed(head->event, head->queued_ticks, start_ticks, end_ticks);
+        flight_recorder_event_processed(head->event, old_state, (STATE)current_state, last_response);
+    }
+
+    m_event_queue.head++;
+
+    // Keep acknowledging a stream of commands cumulatively until it runs dry
+    if(!events_queued() || m_event_queue.slots[m_event_queue.head & (MAX_EVENTS - 1)].event != EVT_COMMAND_SET){
+        command_ack_flush();
+    }
+
+    // Everything the handler responded goes out as one notification
+    link_tx_flush();
+
+    if(current_state < NUM_STATES){
+        LOG_INFO("Current State - %s", st_str[current_state]);
+    }
+}
+
+uint32_t events_dropped(){
+    return m_event_queue.overflows;
+}
+
+STATE current_state_get(){
+    return (STATE) current_state;
+}
+
+bool events_queued(){
+    if(m_event_queue.head != m_event_queue.tail){
+        return true;
+    }
+    return false;
+}
+
+void connection_timeout(void * p_context){
+    power_profile_wake_reason(POWER_WAKE_TIMER);
+    add_event(EVT_TIMED_OUT, NULL, 0);
+}
+
+void passcode_timeout(void * p_context){
+    power_profile_wake_reason(POWER_WAKE_TIMER);
+    add_event(EVT_PASSCODE_TIMED_OUT, NULL, 0);
+}
+
+void starter_timeout(void * p_context){
+		power_profile_wake_reason(POWER_WAKE_TIMER);
+		op_starter(0);
+}
+
+int8_t op_invalid(uint32_t toggle){
+    LOG_INFO("Setting Operation Invalid to %d", toggle);
+		LOG_ERROR("Attempt to run Invalid Operation");
+		return 0;
+}
+
+int8_t op_lock(uint32_t toggle){
+    LOG_INFO("Setting Operation Lock to %d", toggle);
+		if(toggle){
+			nrf_gpio_pin_set(LED_1);
+		} else {
+			nrf_gpio_pin_clear(LED_1);
+		}
+		return 0;
+}
+
+int8_t op_ignition(uint32_t toggle){
+    LOG_INFO("Setting Operation Ignition to %d", toggle);
+		if(toggle){
+			nrf_gpio_pin_set(LED_2);
+		} else {
+			nrf_gpio_pin_clear(LED_2);
+		}
+		return 0;
+}
+
+int8_t op_starter(uint32_t toggle){
+    LOG_INFO("Setting Operation Starter to %d", toggle);
+		if(toggle){
+			app_timer_restart(m_starter_timer_id, STARTER_INTERVAL, 0);
+			
+			nrf_gpio_pin_set(LED_3);
+		} else {
+			nrf_gpio_pin_clear(LED_3);
+		}
+		return 0;
+}
+
+int8_t op_panic(uint32_t toggle){
+    LOG_INFO("Setting Operation Panic to %d", toggle);
+		if(toggle){
+			NRF_GPIO->OUTSET = OUT_PANIC_MASK;
+		} else {
+			NRF_GPIO->OUTCLR = OUT_PANIC_MASK;
+		}
+		return 0;
+}
+
+int8_t op_get_millis(uint32_t arg){
+	
+		UNUSED_PARAMETER(arg);
+	
+		uint32_t millis = rotation_phase_ms();
+	
+		millis = ENDIAN_SWAP_32(millis);
+	
+		send_response_data(&millis, 4);
+		return 0;
+}
+
+int8_t op_sync_timer(uint32_t arg){
+		
+		app_timer_restart(m_passcode_rotate_timer_id, PASSCODE_ROTATE_INTERVAL, 0);
+		passcode_rotate_timer_start_ticks = timebase_ticks();
+		rotate_timer_realign = false;
+		position_save();
+		return 0;
+}
+
+int8_t op_sync_timer_adv(uint32_t arg){
+		app_timer_restart(m_passcode_rotate_timer_id, PASSCODE_ROTATE_INTERVAL, 0);
+		rotate_timer_realign = false;
+		passcodes_advance(1);
+		position_save();
+		add_event(EVT_PASSCODE_TIMED_OUT, NULL, 0);
+		return 0;
+}
+
+// Refuses more than FAST_FORWARD_MAX_ROTATIONS, or a jump that would wrap the
+// draw number back round to 0 (unseeded), with -8 and leaves the passcodes be
+int8_t op_fast_forward(uint32_t rotations){
+		if(rotations > FAST_FORWARD_MAX_ROTATIONS || rotations > UINT32_MAX - passcode_current){
+				LOG_WARN("Refused fast forwarding by %u rotations", rotations);
+				return -8;
+		}
+
+		LOG_INFO("Fast forwarding passcodes by %d rotations", rotations);
+		app_timer_restart(m_passcode_rotate_timer_id, PASSCODE_ROTATE_INTERVAL, 0);
+		passcode_rotate_timer_start_ticks = timebase_ticks();
+		rotate_timer_realign = false;
+
+		passcodes_advance(rotations);
+		position_save();
+		return 0;
+}
+
+#ifdef POWER_PROFILING
+static void put_be32(uint8_t* p_out, uint32_t value){
+		p_out[0] = value >> 24;
+		p_out[1] = value >> 16;
+		p_out[2] = value >> 8;
+		p_out[3] = value;
+}
+#endif
+
+// Responds with the awake and asleep milliseconds, wakeups and wake reasons of
+// one STATE (20 bytes, big endian), or dumps every state over RTT if the
+// operand is POWER_STATS_DUMP.
+int8_t op_power_stats(uint32_t state){
+#ifdef POWER_PROFILING
+		power_stats_t stats;
+		uint8_t response[20];
+
+		if(state == POWER_STATS_DUMP){
+				power_profile_dump();
+				return 0;
+		}
+		if(state >= NUM_STATES){
+				return -8;
+		}
+		power_profile_get((STATE) state, &stats);
+
+		put_be32(&response[0], (uint32_t)timebase_ticks_to_ms(stats.awake_ticks));
+		put_be32(&response[4], (uint32_t)timebase_ticks_to_ms(stats.asleep_ticks));
+		put_be32(&response[8], stats.wakeups);
+		for(int reason = 0; reason < NUM_POWER_WAKES; reason++){
+				uint32_t count = stats.wake_reasons[reason];
+				if(count > UINT16_MAX){
+						count = UINT16_MAX;
+				}
+				response[12 + 2 * reason] = count >> 8;
+				response[13 + 2 * reason] = count;
+		}
+
+		send_response_data(response, sizeof(response));
+		return 0;
+#else
+		LOG_WARN("Power profiling is not compiled in");
+		return -1;
+#endif
+}
+
+// Sets several outputs at once. Bits 8-11 of the operand select the lock,
+// ignition, starter and panic outputs to change and bits 0-3 give their new
+// levels, so 0x0302 turns the lock off and the ignition on. The new levels
+// are written to OUT in one store, so every selected pin switches in the
+// same cycle. The starter still stops itself after STARTER_INTERVAL.
+int8_t op_scene(uint32_t scene){
+		uint8_t select = (scene >> 8) & ((1 << SCENE_BITS) - 1);
+		uint32_t mask = 0;
+		uint32_t levels = 0;
+
+		LOG_INFO("Setting Scene %03X", scene & 0xFFF);
+		for(uint8_t bit = 0; bit < SCENE_BITS; bit++){
+				if(select & (1 << bit)){
+						mask |= scene_outputs[bit];
+						if(scene & (1 << bit)){
+								levels |= scene_outputs[bit];
+						}
+				}
+		}
+
+		// Other pins of OUT are driven from interrupts (the BSP LEDs)
+		CRITICAL_REGION_ENTER();
+		NRF_GPIO->OUT = (NRF_GPIO->OUT & ~mask) | levels;
+		CRITICAL_REGION_EXIT();
+
+		if(levels & OUT_STARTER_MASK){
+				app_timer_restart(m_starter_timer_id, STARTER_INTERVAL, 0);
+		}
+		return 0;
+}
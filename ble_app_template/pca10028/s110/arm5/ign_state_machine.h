@@ -1,104 +1,106 @@
-/*
- *  Ignition Controller State Machine
- */
-
-#ifndef IGN_STATE_MACHINE_H__
-#define IGN_STATE_MACHINE_H__
-
-#define MAX_EVENTS 10
-
-#include <stdint.h>
-#include <stdlib.h>
-#include <stdbool.h>
-#include <string.h>
-#include <inttypes.h>
-#include "logger.h"
-#include "ble_boc.h"
-#include "mt19937-64.h"
-//#include "tinymt64.h"
-#include "ble_hci.h"
-#include "app_timer.h"
-#include "boards.h"
-#include "nordic_common.h"
-
-// Forward declaration of the ble_boc_t type. 
-typedef struct ble_boc_s ble_boc_t;
-
-typedef enum {  ST_INVALID,
-                ST_UNSEEDED,
-                ST_UNSEEDED_CONNECTED,
-                ST_IDLE, 
-                ST_CONNECTED, 
-                ST_LOCKED, 
-                ST_UNLOCKED, 
-                NUM_STATES
-} STATE;
-
-static char* st_str[] = {
-                "ST_INVALID",
-                "ST_UNSEEDED", 
-                "ST_UNSEEDED_CONNECTED",
-                "ST_IDLE", 
-                "ST_CONNECTED", 
-                "ST_LOCKED", 
-                "ST_UNLOCKED"
-};
-
-typedef enum {  EVT_INVALID,
-                EVT_BUTTON_PRESS,
-                EVT_PASSCODE_SET,
-                EVT_CONNECTED,
-                EVT_DISCONNECTED,
-                EVT_TIMED_OUT,
-                EVT_PASSCODE_TIMED_OUT,
-                EVT_OPERATION_SET,
-                EVT_OPERAND_SET,
-                NUM_EVENTS
-} EVENT;
-
-static char* evt_str[] = {
-                "EVT_INVALID",
-                "EVT_BUTTON_PRESS",
-                "EVT_PASSCODE_SET",
-                "EVT_CONNECTED",
-                "EVT_DISCONNECTED",
-                "EVT_TIMED_OUT",
-                "EVT_PASSCODE_TIMED_OUT",
-                "EVT_OPERATION_SET",
-                "EVT_OPERAND_SET"
-};
-
-typedef enum {  OP_INVALID,
-                OP_LOCK,
-                OP_IGNITION,
-                OP_STARTER,
-                OP_PANIC,
-								OP_GET_MILLIS,
-								OP_SYNC_TIMER,
-								OP_SYNC_TIMER_ADV,
-                NUM_OPERATIONS
-} OPERATION;
-
-static char* op_str[] = {
-                "OP_INVALID",
-                "OP_LOCK",
-                "OP_IGNITION",
-                "OP_STARTER",
-                "OP_PANIC",
-								"OP_GET_MILLIS",
-								"OP_SYNC_TIMER",
-								"OP_SYNC_TIMER_ADV"
-};
-
-typedef struct queued_event_s {
-        EVENT event;
-        void* data;
-        uint8_t size;
-        struct queued_event_s* next;
-} queued_event_t;                        
-
-void state_machine_init(ble_boc_t boc);
-void add_event(EVENT event, void* data, uint8_t size);
-void process_event(void);
-bool events_queued(void);
-#endif
+/*
+ *  Ignition Controller State Machine
+ */
+
+#ifndef IGN_STATE_MACHINE_H__
+#define IGN_STATE_MACHINE_H__
+
+#define MAX_EVENTS 16                            // Event queue capacity, must be a power of two
+#define MAX_EVENT_DATA 20                       // Largest characteristic write carried by an event
+
+// Passcodes accepted around the current one. A guess matching another one than
+// the current is answered with its offset, so the phone can correct its clock.
+#ifndef PASSCODE_LOOKBEHIND
+#define PASSCODE_LOOKBEHIND 1                   // Earlier passcodes still accepted
+#endif
+#ifndef PASSCODE_LOOKAHEAD
+#define PASSCODE_LOOKAHEAD 1                    // Later passcodes already accepted
+#endif
+#define PASSCODE_WINDOW (PASSCODE_LOOKBEHIND + 1 + PASSCODE_LOOKAHEAD)  // 3 to 16
+
+// Command frame written to the command characteristic in one ATT write. The
+// passcode and operand are big endian, like their separate characteristics.
+#define CMD_PASSCODE_OFFSET 0                   // 8 byte passcode
+#define CMD_OPCODE_OFFSET 8                     // 1 byte OPERATION
+#define CMD_OPERAND_OFFSET 9                    // 4 byte operand
+#define CMD_SEQ_OFFSET 13                       // 1 byte sequence number, echoed in the response
+#define CMD_FRAME_LEN 14
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Forward declaration of the ble_boc_t type. 
+typedef struct ble_boc_s ble_boc_t;
+
+typedef enum {  ST_INVALID,
+                ST_UNSEEDED,
+                ST_UNSEEDED_CONNECTED,
+                ST_IDLE, 
+                ST_CONNECTED, 
+                ST_LOCKED, 
+                ST_UNLOCKED, 
+                NUM_STATES
+} STATE;
+
+typedef enum {  EVT_INVALID,
+                EVT_BUTTON_PRESS,
+                EVT_PASSCODE_SET,
+                EVT_CONNECTED,
+                EVT_DISCONNECTED,
+                EVT_TIMED_OUT,
+                EVT_PASSCODE_TIMED_OUT,
+                EVT_OPERATION_SET,
+                EVT_OPERAND_SET,
+                EVT_COMMAND_SET,
+                NUM_EVENTS
+} EVENT;
+
+typedef enum {  OP_INVALID,
+                OP_LOCK,
+                OP_IGNITION,
+                OP_STARTER,
+                OP_PANIC,
+								OP_GET_MILLIS,
+								OP_SYNC_TIMER,
+								OP_SYNC_TIMER_ADV,
+                OP_FAST_FORWARD,
+                OP_POWER_STATS,
+                OP_SCENE,
+                NUM_OPERATIONS
+} OPERATION;
+
+typedef struct {
+        EVENT event;
+        uint8_t size;
+        uint8_t data[MAX_EVENT_DATA];
+        uint32_t queued_ticks;                  // RTC1 counter when the event was queued
+} queued_event_t;
+
+// Runs the side effects of an event and returns true if the transition to the
+// next state should be taken.
+typedef bool (*transition_handler_t)(queued_event_t* event);
+
+typedef struct {
+        transition_handler_t handler;
+        STATE next_state;
+} transition_t;
+
+// Events are produced from the SoftDevice, app_timer and UART handlers and
+// from the main loop itself (op_sync_timer_adv(), closing a UART session),
+// which those handlers can preempt, so add_event() claims a slot inside a
+// critical region. Only the main loop consumes.
+typedef struct {
+        queued_event_t slots[MAX_EVENTS];
+        volatile uint8_t head;                  // Next slot to process, only written by the consumer
+        volatile uint8_t tail;                  // Next free slot, written by add_event() in a critical region
+        uint32_t overflows;                     // Events dropped because the queue was full
+} event_queue_t;
+
+void state_machine_init(ble_boc_t * p_boc);
+void add_event(EVENT event, void* data, uint8_t size);
+void process_event(void);
+bool events_queued(void);
+uint32_t events_dropped(void);
+STATE current_state_get(void);
+void passcodes_refill(void);
+#endif
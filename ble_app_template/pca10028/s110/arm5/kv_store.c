@@ -0,0 +1,386 @@
+#include <stddef.h>
+#include <string.h>
+#include "kv_store.h"
+#include "crc16_ccitt.h"
+#include "logger.h"
+#include "pstorage.h"
+#include "app_error.h"
+#include "app_util_platform.h"
+#include "nordic_common.h"
+
+#define KV_STORE_PAGES 2
+#define KV_STORE_EMPTY 0xFFFFFFFF               // Erased flash
+#define KV_STORE_WORDS(len) (((len) + 3) / 4)
+
+// Record header, followed by the value padded to a whole word. The header is
+// the first word written, so a record cut short by a reset can still be
+// stepped over; its CRC won't match.
+typedef struct {
+    uint8_t key;
+    uint8_t len;                                // 0 for a deleted key
+    uint16_t crc;                               // Over the sequence number and the value
+    uint32_t sequence;                          // Incremented per record, the highest one of a key is current
+} kv_header_t;
+
+#define KV_RECORD_MAX (sizeof(kv_header_t) + KV_STORE_MAX_VALUE)
+
+typedef struct {
+    uint32_t sequence;                          // Record holding the value, 0 if never written
+    uint8_t len;                                // 0 when the key has no value
+    bool dirty;                                 // Changed since it was last written
+    uint32_t value[KV_STORE_MAX_VALUE / 4];
+} kv_entry_t;
+
+static pstorage_handle_t m_base_handle;         // One pstorage block per page
+static kv_entry_t m_entries[NUM_KV_KEYS];
+static uint32_t m_buffer[(KV_RECORD_MAX * NUM_KV_KEYS) / 4];    // pstorage_store() keeps the pointer until it completes
+static uint8_t m_batch_keys;                    // Bit per key written from m_buffer
+static bool m_write_busy = false;
+static bool m_compact_pending = false;
+static bool m_compacting = false;                // The store in flight is a compaction onto the other page
+static uint16_t m_compact_size;                 // Bytes it writes there
+static uint32_t m_sequence = 0;
+static uint8_t m_page;                          // Active page, records are appended to it
+static uint16_t m_offset;                       // Where the next record goes in m_page
+static bool m_spare_erased = false;             // The other page is known to be erased
+
+static uint16_t record_crc(uint32_t sequence, const void* p_value, uint8_t len){
+    uint16_t crc = crc16_update(CRC16_CCITT_INIT, (const uint8_t*)&sequence, sizeof(sequence));
+    return crc16_update(crc, p_value, len);
+}
+
+static uint16_t record_size(uint8_t len){
+    return sizeof(kv_header_t) + KV_STORE_WORDS(len) * 4;
+}
+
+static void page_handle_get(uint8_t page, pstorage_handle_t* p_handle){
+    uint32_t err_code = pstorage_block_identifier_get(&m_base_handle, page, p_handle);
+    APP_ERROR_CHECK(err_code);
+}
+
+// Caches the newest value of every key found in a page and returns the
+// offset after its last record, or the page size if the rest is unusable
+static uint16_t page_scan(uint8_t page){
+    pstorage_handle_t handle;
+    kv_header_t header;
+    uint32_t value[KV_STORE_MAX_VALUE / 4];
+    uint16_t offset = 0;
+    uint32_t err_code;
+
+    page_handle_get(page, &handle);
+
+    while(offset + sizeof(kv_header_t) <= PSTORAGE_FLASH_PAGE_SIZE){
+        err_code = pstorage_load((uint8_t*)&header, &handle, sizeof(header), offset);
+        APP_ERROR_CHECK(err_code);
+
+        if(*(uint32_t*)&header == KV_STORE_EMPTY){
+            break;
+        }
+        if(header.len > KV_STORE_MAX_VALUE || offset + record_size(header.len) > PSTORAGE_FLASH_PAGE_SIZE){
+            LOG_WARN("KV store page %d corrupt at %d", page, offset);
+            return PSTORAGE_FLASH_PAGE_SIZE;
+        }
+
+        memset(value, 0, sizeof(value));
+        if(header.len){
+            err_code = pstorage_load((uint8_t*)value, &handle, KV_STORE_WORDS(header.len) * 4, offset + sizeof(header));
+            APP_ERROR_CHECK(err_code);
+        }
+
+        // Torn records and keys of other firmware versions are stepped over
+        if(header.crc == record_crc(header.sequence, value, header.len) && header.key < NUM_KV_KEYS){
+            kv_entry_t* p_entry = &m_entries[header.key];
+
+            if(header.sequence > p_entry->sequence){
+                p_entry->sequence = header.sequence;
+                p_entry->len = header.len;
+                memcpy(p_entry->value, value, sizeof(value));
+            }
+            if(header.sequence > m_sequence){
+                m_sequence = header.sequence;
+                m_page = page;
+            }
+        }
+
+        offset += record_size(header.len);
+    }
+    return offset;
+}
+
+static uint16_t record_serialize(uint8_t* p_out, KV_KEY key){
+    kv_entry_t* p_entry = &m_entries[key];
+    kv_header_t header;
+
+    header.key = key;
+    header.len = p_entry->len;
+    header.sequence = ++m_sequence;
+    header.crc = record_crc(header.sequence, p_entry->value, p_entry->len);
+
+    memcpy(p_out, &header, sizeof(header));
+    memcpy(p_out + sizeof(header), p_entry->value, KV_STORE_WORDS(p_entry->len) * 4);
+
+    p_entry->sequence = header.sequence;
+    p_entry->dirty = false;
+    m_batch_keys |= 1 << key;
+
+    return record_size(p_entry->len);
+}
+
+static void batch_failed(void){
+    for(int key = 0; key < NUM_KV_KEYS; key++){
+        if(m_batch_keys & (1 << key)){
+            m_entries[key].dirty = true;
+        }
+    }
+    m_batch_keys = 0;
+}
+
+// Makes the other page active once the live values are in it, and erases
+// the old one. Until then a reset finds everything on the old page.
+static void compact_done(void){
+    uint8_t old_page = m_page;
+    pstorage_handle_t handle;
+    uint32_t err_code;
+
+    m_page = (old_page + 1) % KV_STORE_PAGES;
+    m_offset = m_compact_size;
+
+    page_handle_get(old_page, &handle);
+    err_code = pstorage_clear(&handle, PSTORAGE_FLASH_PAGE_SIZE);
+    if(err_code == NRF_SUCCESS){
+        m_spare_erased = true;
+    } else {
+        // Erased before the next compaction writes to it
+        LOG_WARN("KV store erase of page %d failed %d", old_page, err_code);
+    }
+
+    LOG_INFO("KV store compacted to page %d, %d bytes", m_page, m_compact_size);
+}
+
+// Copies the live values to the other page, which becomes active when the
+// copy is written
+static uint32_t compact(void){
+    uint8_t* p_out = (uint8_t*)m_buffer;
+    uint16_t size = 0;
+    pstorage_handle_t handle;
+    uint32_t err_code;
+
+    for(int key = 0; key < NUM_KV_KEYS; key++){
+        if(m_entries[key].len){
+            size += record_serialize(p_out + size, (KV_KEY)key);
+        } else {
+            // Deleted keys are dropped with the page
+            m_entries[key].dirty = false;
+        }
+    }
+
+    page_handle_get((m_page + 1) % KV_STORE_PAGES, &handle);
+
+    if(!m_spare_erased){
+        err_code = pstorage_clear(&handle, PSTORAGE_FLASH_PAGE_SIZE);
+        if(err_code != NRF_SUCCESS){
+            return err_code;
+        }
+        m_spare_erased = true;
+    }
+
+    m_compact_size = size;
+    if(size == 0){
+        compact_done();
+        return NRF_SUCCESS;
+    }
+
+    err_code = pstorage_store(&handle, (uint8_t*)m_buffer, size, 0);
+    if(err_code != NRF_SUCCESS){
+        return err_code;
+    }
+    m_spare_erased = false;
+    m_compacting = true;
+    m_write_busy = true;
+    return NRF_SUCCESS;
+}
+
+// Writes every changed key as one store, compacting first when they don't fit
+static void flush(void){
+    uint8_t* p_out = (uint8_t*)m_buffer;
+    uint16_t size = 0;
+    pstorage_handle_t handle;
+    uint32_t err_code;
+
+    if(m_write_busy){
+        return;
+    }
+
+    m_batch_keys = 0;
+
+    for(int key = 0; key < NUM_KV_KEYS; key++){
+        if(m_entries[key].dirty){
+            size += record_size(m_entries[key].len);
+        }
+    }
+
+    if(m_compact_pending || m_offset + size > PSTORAGE_FLASH_PAGE_SIZE){
+        m_compact_pending = false;
+        err_code = compact();
+        if(err_code != NRF_SUCCESS){
+            LOG_WARN("KV store compaction failed %d", err_code);
+            batch_failed();
+            m_compact_pending = true;
+        }
+        return;
+    }
+
+    if(size == 0){
+        return;
+    }
+
+    size = 0;
+    for(int key = 0; key < NUM_KV_KEYS; key++){
+        if(m_entries[key].dirty){
+            size += record_serialize(p_out + size, (KV_KEY)key);
+        }
+    }
+
+    page_handle_get(m_page, &handle);
+    err_code = pstorage_store(&handle, (uint8_t*)m_buffer, size, m_offset);
+    if(err_code != NRF_SUCCESS){
+        // Retried with the next put
+        LOG_WARN("KV store write failed %d", err_code);
+        batch_failed();
+        return;
+    }
+
+    m_offset += size;
+    m_write_busy = true;
+}
+
+static void kv_store_cb(pstorage_handle_t* p_handle, uint8_t op_code, uint32_t result, uint8_t* p_data, uint32_t data_len){
+    if(result != NRF_SUCCESS){
+        LOG_WARN("KV store flash operation %d failed %d", op_code, result);
+    }
+
+    if(op_code == PSTORAGE_CLEAR_OP_CODE && result != NRF_SUCCESS){
+        m_spare_erased = false;
+    }
+
+    if(op_code != PSTORAGE_STORE_OP_CODE){
+        return;
+    }
+
+    m_write_busy = false;
+
+    if(result != NRF_SUCCESS){
+        // Retried with the next put
+        batch_failed();
+        if(m_compacting){
+            m_compacting = false;
+            m_compact_pending = true;
+        }
+        return;
+    }
+
+    if(m_compacting){
+        m_compacting = false;
+        compact_done();
+    }
+
+    // Puts made meanwhile go out as one write
+    flush();
+}
+
+// Must run after pstorage_init() and after the device manager registered, so
+// the bond page keeps its place in flash.
+void kv_store_init(void){
+    pstorage_module_param_t param;
+    uint16_t ends[KV_STORE_PAGES];
+    uint32_t err_code;
+
+    param.block_size  = PSTORAGE_FLASH_PAGE_SIZE;
+    param.block_count = KV_STORE_PAGES;
+    param.cb          = kv_store_cb;
+
+    err_code = pstorage_register(&param, &m_base_handle);
+    APP_ERROR_CHECK(err_code);
+
+    memset(m_entries, 0, sizeof(m_entries));
+    m_sequence = 0;
+    m_page = 0;
+
+    for(uint8_t page = 0; page < KV_STORE_PAGES; page++){
+        ends[page] = page_scan(page);
+    }
+    m_offset = ends[m_page];
+
+    LOG_INFO("KV store on page %d at %d, sequence %d", m_page, m_offset, m_sequence);
+}
+
+// Copies up to size bytes of the value and returns its length, 0 if the key has none
+uint8_t kv_store_get(KV_KEY key, void* p_value, uint8_t size){
+    if(key >= NUM_KV_KEYS){
+        return 0;
+    }
+
+    kv_entry_t* p_entry = &m_entries[key];
+    uint8_t len;
+
+    CRITICAL_REGION_ENTER();
+    len = p_entry->len;
+    memcpy(p_value, p_entry->value, MIN(size, len));
+    CRITICAL_REGION_EXIT();
+    return len;
+}
+
+uint32_t kv_store_put(KV_KEY key, const void* p_value, uint8_t len){
+    if(key >= NUM_KV_KEYS || len == 0 || len > KV_STORE_MAX_VALUE){
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    kv_entry_t* p_entry = &m_entries[key];
+
+    // flush() also runs from the pstorage callback, in the SoftDevice event interrupt
+    CRITICAL_REGION_ENTER();
+    // Unchanged, or already waiting to be written
+    if(p_entry->len != len || memcmp(p_entry->value, p_value, len) != 0){
+        memset(p_entry->value, 0, sizeof(p_entry->value));
+        memcpy(p_entry->value, p_value, len);
+        p_entry->len = len;
+        p_entry->dirty = true;
+
+        flush();
+    }
+    CRITICAL_REGION_EXIT();
+    return NRF_SUCCESS;
+}
+
+// Deleting only appends a marker, the old value stays in flash until the
+// next compaction
+uint32_t kv_store_delete(KV_KEY key){
+    if(key >= NUM_KV_KEYS){
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    kv_entry_t* p_entry = &m_entries[key];
+
+    CRITICAL_REGION_ENTER();
+    if(p_entry->len != 0){
+        memset(p_entry->value, 0, sizeof(p_entry->value));
+        p_entry->len = 0;
+        p_entry->dirty = true;
+
+        flush();
+    }
+    CRITICAL_REGION_EXIT();
+    return NRF_SUCCESS;
+}
+
+// Rewrites the live values to the other page and erases the active one, so
+// deleted values no longer exist in flash
+void kv_store_compact(void){
+    CRITICAL_REGION_ENTER();
+    // Nothing to scrub while the active page is empty
+    if(m_offset != 0 || m_write_busy){
+        m_compact_pending = true;
+        flush();
+    }
+    CRITICAL_REGION_EXIT();
+}
@@ -0,0 +1,32 @@
+/*
+ *  Key/Value Store
+ *
+ *  Append-only store for small settings over two pstorage pages. Each put
+ *  appends a {key, length, CRC, sequence} record to the active page instead
+ *  of rewriting it through pstorage's swap page; only when the active page
+ *  fills are the live records compacted onto the other page and the full one
+ *  erased, so both pages wear evenly. The newest value of every key is
+ *  cached in RAM, rebuilt from flash at boot, and puts made while a write is
+ *  in flight are batched into the next one.
+ */
+
+#ifndef KV_STORE_H__
+#define KV_STORE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define KV_STORE_MAX_VALUE 32                   // Largest value in bytes, must be a multiple of 4
+
+typedef enum {  KV_KEY_SEED,
+                KV_KEY_SEED_POSITION,
+                NUM_KV_KEYS
+} KV_KEY;
+
+void kv_store_init(void);
+uint8_t kv_store_get(KV_KEY key, void* p_value, uint8_t size);
+uint32_t kv_store_put(KV_KEY key, const void* p_value, uint8_t len);
+uint32_t kv_store_delete(KV_KEY key);
+void kv_store_compact(void);
+
+#endif
@@ -1,38 +1,115 @@
-
-#ifndef LOGGER_H__
-#define LOGGER_H__
-
-#include "SEGGER_RTT.h"
-#include "app_error.h"
-
-#define LEVEL 5
-
-#ifdef  DEBUG
-#define DEBUG_TEST 1
-#define LOG_LEVEL LEVEL
-#else
-#define DEBUG_TEST 0
-#define LOG_LEVEL 0
-#endif
-
-#define __FILENAME__ (strrchr(__FILE__, '\\') ? strrchr(__FILE__, '\\') + 1 : __FILE__)
-
-#define LOG_CLEAR() \
-	do { if (DEBUG_TEST && LOG_LEVEL > 0) SEGGER_RTT_printf(0, "%s%s", RTT_CTRL_CLEAR, RTT_CTRL_RESET); } while (0)
-
-#define LOG_DEBUG(format, ...) \
-    do { if (DEBUG_TEST && LOG_LEVEL > 4) SEGGER_RTT_printf(0, "%s%s[DEBUG] " format "\n", RTT_CTRL_BG_BLACK, RTT_CTRL_TEXT_WHITE, ##__VA_ARGS__); } while (0)
-		
-#define LOG_INFO(format, ...) \
-    do { if (DEBUG_TEST && LOG_LEVEL > 3) SEGGER_RTT_printf(0, "%s%s[ INFO] " format "\n", RTT_CTRL_BG_BLACK, RTT_CTRL_TEXT_BRIGHT_GREEN, ##__VA_ARGS__); } while (0)
-
-#define LOG_WARN(format, ...) \
-    do { if (DEBUG_TEST && LOG_LEVEL > 2) SEGGER_RTT_printf(0, "%s%s[ WARN] %s(%d): " format "\n", RTT_CTRL_BG_BLACK, RTT_CTRL_TEXT_BRIGHT_YELLOW, __FILENAME__, __LINE__, ##__VA_ARGS__); } while (0)
-
-#define LOG_ERROR(format, ...) \
-    do { if (DEBUG_TEST && LOG_LEVEL > 1) SEGGER_RTT_printf(0, "%s%s[ERROR] %s(%d): " format "\n", RTT_CTRL_BG_BLACK, RTT_CTRL_TEXT_BRIGHT_RED, __FILENAME__, __LINE__, ##__VA_ARGS__); } while (0)
-
-#define LOG_FATAL(format, ...) \
-    do { if (DEBUG_TEST && LOG_LEVEL > 0) SEGGER_RTT_printf(0, "%s%s[FATAL] %s(%d): " format "\n", RTT_CTRL_BG_RED, RTT_CTRL_TEXT_WHITE, __FILENAME__, __LINE__, ##__VA_ARGS__); APP_ERROR_CHECK(NRF_ERROR_NO_MEM); } while (0)
-
-#endif
+
+#ifndef LOGGER_H__
+#define LOGGER_H__
+
+#include <stdint.h>
+#include "SEGGER_RTT.h"
+#include "app_error.h"
+#include "timebase.h"
+
+#define LEVEL 5
+
+// Every record is stamped with the milliseconds since boot
+#define LOG_TIME() ((uint32_t)timebase_ms())
+
+#ifdef  DEBUG
+#define DEBUG_TEST 1
+#define LOG_LEVEL LEVEL
+#else
+#define DEBUG_TEST 0
+#define LOG_LEVEL 0
+#endif
+
+// armcc provides the file name without its path at compile time
+#ifdef __MODULE__
+#define __FILENAME__ __MODULE__
+#else
+#define __FILENAME__ (strrchr(__FILE__, '\\') ? strrchr(__FILE__, '\\') + 1 : __FILE__)
+#endif
+
+#ifdef LOG_DEFERRED
+
+/*
+ *  Deferred logging. A call site only writes the address of its format string
+ *  followed by its timestamp and its arguments, each as a 32-bit word, to RTT. The format strings
+ *  (with level, file and line) are kept in the log_fmt section and
+ *  tools/rtt_log_decode.py rebuilds the text from the binary stream and the .axf.
+ *
+ *  log_fmt still goes to flash: the project has no scatter file, so armlink
+ *  merges it into ER_IROM1. Leaving it out would take a load region of its
+ *  own, and uVision tries to program every load region of the .axf. What the
+ *  mode saves is the formatting, not the strings.
+ */
+
+#ifdef __MODULE__
+#define LOG_FILE __MODULE__
+#else
+#define LOG_FILE __FILE__
+#endif
+
+#define LOG_STR_(x) #x
+#define LOG_STR(x) LOG_STR_(x)
+#define LOG_CAT_(a, b) a##b
+#define LOG_CAT(a, b) LOG_CAT_(a, b)
+
+#define LOG_NARGS(...) LOG_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, N, ...) N
+
+#define LOG_ARGS_0()
+#define LOG_ARGS_1(a)                   , (uint32_t)(uintptr_t)(a)
+#define LOG_ARGS_2(a, b)                LOG_ARGS_1(a) LOG_ARGS_1(b)
+#define LOG_ARGS_3(a, b, c)             LOG_ARGS_1(a) LOG_ARGS_2(b, c)
+#define LOG_ARGS_4(a, b, c, d)          LOG_ARGS_1(a) LOG_ARGS_3(b, c, d)
+#define LOG_ARGS_5(a, b, c, d, e)       LOG_ARGS_1(a) LOG_ARGS_4(b, c, d, e)
+#define LOG_ARGS_6(a, b, c, d, e, f)    LOG_ARGS_1(a) LOG_ARGS_5(b, c, d, e, f)
+#define LOG_ARGS(...) LOG_CAT(LOG_ARGS_, LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+#define LOG_RECORD(level, format, ...) \
+    do { \
+        static const char log_fmt[] __attribute__((section("log_fmt"), used)) = \
+            level "\x1f" LOG_FILE "\x1f" LOG_STR(__LINE__) "\x1f" format; \
+        const uint32_t log_record[] = { (uint32_t)(uintptr_t)log_fmt, LOG_TIME() LOG_ARGS(__VA_ARGS__) }; \
+        SEGGER_RTT_Write(0, log_record, sizeof(log_record)); \
+    } while (0)
+
+#define LOG_CLEAR() \
+	do { } while (0)
+
+#define LOG_DEBUG(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 4) LOG_RECORD("D", format, ##__VA_ARGS__); } while (0)
+
+#define LOG_INFO(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 3) LOG_RECORD("I", format, ##__VA_ARGS__); } while (0)
+
+#define LOG_WARN(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 2) LOG_RECORD("W", format, ##__VA_ARGS__); } while (0)
+
+#define LOG_ERROR(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 1) LOG_RECORD("E", format, ##__VA_ARGS__); } while (0)
+
+#define LOG_FATAL(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 0) LOG_RECORD("F", format, ##__VA_ARGS__); APP_ERROR_CHECK(NRF_ERROR_NO_MEM); } while (0)
+
+#else
+
+#define LOG_CLEAR() \
+	do { if (DEBUG_TEST && LOG_LEVEL > 0) SEGGER_RTT_printf(0, "%s%s", RTT_CTRL_CLEAR, RTT_CTRL_RESET); } while (0)
+
+#define LOG_DEBUG(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 4) SEGGER_RTT_printf(0, "%s%s%8u [DEBUG] " format "\n", RTT_CTRL_BG_BLACK, RTT_CTRL_TEXT_WHITE, LOG_TIME(), ##__VA_ARGS__); } while (0)
+		
+#define LOG_INFO(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 3) SEGGER_RTT_printf(0, "%s%s%8u [ INFO] " format "\n", RTT_CTRL_BG_BLACK, RTT_CTRL_TEXT_BRIGHT_GREEN, LOG_TIME(), ##__VA_ARGS__); } while (0)
+
+#define LOG_WARN(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 2) SEGGER_RTT_printf(0, "%s%s%8u [ WARN] %s(%d): " format "\n", RTT_CTRL_BG_BLACK, RTT_CTRL_TEXT_BRIGHT_YELLOW, LOG_TIME(), __FILENAME__, __LINE__, ##__VA_ARGS__); } while (0)
+
+#define LOG_ERROR(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 1) SEGGER_RTT_printf(0, "%s%s%8u [ERROR] %s(%d): " format "\n", RTT_CTRL_BG_BLACK, RTT_CTRL_TEXT_BRIGHT_RED, LOG_TIME(), __FILENAME__, __LINE__, ##__VA_ARGS__); } while (0)
+
+#define LOG_FATAL(format, ...) \
+    do { if (DEBUG_TEST && LOG_LEVEL > 0) SEGGER_RTT_printf(0, "%s%s%8u [FATAL] %s(%d): " format "\n", RTT_CTRL_BG_RED, RTT_CTRL_TEXT_WHITE, LOG_TIME(), __FILENAME__, __LINE__, ##__VA_ARGS__); APP_ERROR_CHECK(NRF_ERROR_NO_MEM); } while (0)
+
+#endif
+
+#endif
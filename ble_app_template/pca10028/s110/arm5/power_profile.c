@@ -0,0 +1,69 @@
+#include "power_profile.h"
+
+#ifdef POWER_PROFILING
+
+#include <string.h>
+#include "logger.h"
+#include "timebase.h"
+
+static power_stats_t m_power_stats[NUM_STATES];
+static volatile uint8_t m_wake_reasons;                 // Bit per POWER_WAKE, set from interrupt handlers
+static uint64_t m_sleep_ticks;
+static uint64_t m_wake_ticks;
+static STATE m_sleep_state;
+
+void power_profile_sleep(void){
+    m_sleep_ticks = timebase_ticks();
+    m_sleep_state = current_state_get();
+
+    m_power_stats[m_sleep_state].awake_ticks += m_sleep_ticks - m_wake_ticks;
+
+    // Anything flagged from here on is what woke us up
+    m_wake_reasons = 0;
+}
+
+void power_profile_wake(void){
+    uint8_t reasons = m_wake_reasons;
+    power_stats_t* p_stats = &m_power_stats[m_sleep_state];
+
+    m_wake_ticks = timebase_ticks();
+    p_stats->asleep_ticks += m_wake_ticks - m_sleep_ticks;
+    p_stats->wakeups++;
+
+    if(reasons == 0){
+        reasons = 1 << POWER_WAKE_OTHER;
+    }
+    for(int reason = 0; reason < NUM_POWER_WAKES; reason++){
+        if(reasons & (1 << reason)){
+            p_stats->wake_reasons[reason]++;
+        }
+    }
+}
+
+void power_profile_wake_reason(POWER_WAKE reason){
+    m_wake_reasons |= 1 << reason;
+}
+
+bool power_profile_get(STATE state, power_stats_t* p_stats){
+    if(state >= NUM_STATES){
+        return false;
+    }
+    memcpy(p_stats, &m_power_stats[state], sizeof(power_stats_t));
+    return true;
+}
+
+void power_profile_dump(void){
+    for(int state = 0; state < NUM_STATES; state++){
+        power_stats_t* p_stats = &m_power_stats[state];
+        if(p_stats->wakeups == 0){
+            continue;
+        }
+        LOG_INFO("State %d: %d ticks awake, %d ticks asleep, %d wakeups",
+                 state, (uint32_t)p_stats->awake_ticks, (uint32_t)p_stats->asleep_ticks, p_stats->wakeups);
+        LOG_INFO("State %d wakes: %d BLE, %d timer, %d GPIOTE, %d other", state,
+                 p_stats->wake_reasons[POWER_WAKE_BLE], p_stats->wake_reasons[POWER_WAKE_TIMER],
+                 p_stats->wake_reasons[POWER_WAKE_GPIOTE], p_stats->wake_reasons[POWER_WAKE_OTHER]);
+    }
+}
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ *  Power Profiling
+ *
+ *  Accounts for the time the CPU spends awake and asleep in power_manage(),
+ *  how often it wakes up and why, per state machine STATE. Compiled in only
+ *  when POWER_PROFILING is defined; otherwise every call compiles away.
+ *
+ *  Time is measured with the 64-bit timebase, so sleeps of any length count.
+ *  Wakeups the SoftDevice handles internally count as sleep.
+ */
+
+#ifndef POWER_PROFILE_H__
+#define POWER_PROFILE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ign_state_machine.h"
+
+typedef enum {  POWER_WAKE_BLE,
+                POWER_WAKE_TIMER,
+                POWER_WAKE_GPIOTE,
+                POWER_WAKE_OTHER,
+                NUM_POWER_WAKES
+} POWER_WAKE;
+
+typedef struct {
+        uint64_t awake_ticks;
+        uint64_t asleep_ticks;
+        uint32_t wakeups;
+        uint32_t wake_reasons[NUM_POWER_WAKES]; // A wakeup can have several reasons
+} power_stats_t;
+
+#ifdef POWER_PROFILING
+
+void power_profile_sleep(void);
+void power_profile_wake(void);
+void power_profile_wake_reason(POWER_WAKE reason);
+bool power_profile_get(STATE state, power_stats_t* p_stats);
+void power_profile_dump(void);
+
+#else
+
+#define power_profile_sleep()
+#define power_profile_wake()
+#define power_profile_wake_reason(reason)
+#define power_profile_get(state, p_stats) (false)
+#define power_profile_dump()
+
+#endif
+
+#endif
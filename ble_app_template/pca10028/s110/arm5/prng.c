@@ -0,0 +1,112 @@
+#include "prng.h"
+
+#if PRNG_BACKEND == PRNG_TINYMT64
+
+#include "tinymt64.h"
+
+// Default parameter set of the TinyMT64 reference implementation
+#define PRNG_TINYMT64_MAT1 0xfa051f40
+#define PRNG_TINYMT64_MAT2 0xffd0fff4
+#define PRNG_TINYMT64_TMAT UINT64_C(0x58d02ffeffbfffbc)
+
+static tinymt64_t m_tinymt;
+
+void prng_seed(uint64_t init_key[], uint8_t key_length){
+    m_tinymt.mat1 = PRNG_TINYMT64_MAT1;
+    m_tinymt.mat2 = PRNG_TINYMT64_MAT2;
+    m_tinymt.tmat = PRNG_TINYMT64_TMAT;
+    tinymt64_init_by_array(&m_tinymt, init_key, key_length);
+}
+
+uint64_t prng_next64(void){
+    return tinymt64_generate_uint64(&m_tinymt);
+}
+
+/*
+ *  Jump ahead by multiplying the state with x^steps modulo the characteristic
+ *  polynomial of the generator. The cost only depends on the number of bits
+ *  in steps, not on its value.
+ */
+
+// Characteristic polynomial of the TinyMT64 transition for the parameter set
+// above: x^127 plus the coefficients of x^0..x^126 held in LO/HI
+#define PRNG_TINYMT64_CHAR_LO UINT64_C(0x32dfa9d5959e5d5d)
+#define PRNG_TINYMT64_CHAR_HI UINT64_C(0x145e0ad4a30ec194)
+#define PRNG_TINYMT64_DEGREE  127
+
+// Polynomial over GF(2) of degree < 127, coefficient of x^i in bit i
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+} poly_t;
+
+static void poly_mul_x(poly_t* p){
+    uint64_t overflow = p->hi >> 62;
+
+    p->hi = ((p->hi << 1) | (p->lo >> 63)) & TINYMT64_MASK;
+    p->lo <<= 1;
+    if(overflow){
+        p->lo ^= PRNG_TINYMT64_CHAR_LO;
+        p->hi ^= PRNG_TINYMT64_CHAR_HI;
+    }
+}
+
+static void poly_mul(poly_t* r, const poly_t* a, const poly_t* b){
+    poly_t acc = {0, 0};
+
+    for(int i = PRNG_TINYMT64_DEGREE - 1; i >= 0; i--){
+        poly_mul_x(&acc);
+        if(((i < 64) ? (b->lo >> i) : (b->hi >> (i - 64))) & 1){
+            acc.lo ^= a->lo;
+            acc.hi ^= a->hi;
+        }
+    }
+    *r = acc;
+}
+
+void prng_jump(uint64_t steps){
+    poly_t jump = {1, 0};
+    uint64_t status[2] = {0, 0};
+    int i;
+
+    for(i = 63; i >= 0 && !((steps >> i) & 1); i--);
+    for(; i >= 0; i--){
+        poly_mul(&jump, &jump, &jump);
+        if((steps >> i) & 1){
+            poly_mul_x(&jump);
+        }
+    }
+
+    for(i = 0; i < PRNG_TINYMT64_DEGREE; i++){
+        if(((i < 64) ? (jump.lo >> i) : (jump.hi >> (i - 64))) & 1){
+            status[0] ^= m_tinymt.status[0];
+            status[1] ^= m_tinymt.status[1];
+        }
+        tinymt64_next_state(&m_tinymt);
+    }
+    m_tinymt.status[0] = status[0];
+    m_tinymt.status[1] = status[1];
+}
+
+#elif PRNG_BACKEND == PRNG_MT19937_64
+
+#include "mt19937-64.h"
+
+void prng_seed(uint64_t init_key[], uint8_t key_length){
+    init_by_array64(init_key, key_length);
+}
+
+uint64_t prng_next64(void){
+    return genrand64_int64();
+}
+
+// No polynomial jump for the 12799 bit MT19937-64 state, it steps through
+void prng_jump(uint64_t steps){
+    while(steps--){
+        genrand64_int64();
+    }
+}
+
+#else
+#error "Unknown PRNG_BACKEND"
+#endif
@@ -0,0 +1,34 @@
+/*
+ *  Passcode Pseudorandom Number Generator
+ *
+ *  Thin interface over the generator used to derive passcodes from the seed
+ *  written by the phone. The backend is picked at compile time by defining
+ *  PRNG_BACKEND; the phone app must use the same generator.
+ *
+ *  PRNG_MT19937_64 - 64-bit Mersenne Twister, 1.6 KB of state
+ *  PRNG_TINYMT64   - 64-bit Tiny Mersenne Twister, 32 bytes of state
+ */
+
+#ifndef PRNG_H__
+#define PRNG_H__
+
+#include <stdint.h>
+
+#define PRNG_MT19937_64 0
+#define PRNG_TINYMT64   1
+
+#ifndef PRNG_BACKEND
+#define PRNG_BACKEND PRNG_MT19937_64
+#endif
+
+/* initializes the generator with an array of 64-bit seed words */
+void prng_seed(uint64_t init_key[], uint8_t key_length);
+
+/* generates a random number on [0, 2^64-1]-interval */
+uint64_t prng_next64(void);
+
+/* advances the generator as if prng_next64() had been called steps times; */
+/* bounded time for PRNG_TINYMT64, linear in steps for PRNG_MT19937_64     */
+void prng_jump(uint64_t steps);
+
+#endif
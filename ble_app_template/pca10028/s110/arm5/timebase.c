@@ -0,0 +1,52 @@
+#include "timebase.h"
+#include "power_profile.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "app_error.h"
+#include "nordic_common.h"
+
+#define TIMEBASE_COUNTER_BITS 24
+#define TIMEBASE_REFRESH_INTERVAL (1UL << (TIMEBASE_COUNTER_BITS - 2))  // A quarter of a counter period, in ticks
+
+static app_timer_id_t m_refresh_timer_id;
+static uint32_t m_wraps = 0;                    // Counter wraps seen so far
+static uint32_t m_counter_last = 0;             // Counter at the last read
+
+static void refresh_timeout(void* p_context){
+    UNUSED_PARAMETER(p_context);
+    power_profile_wake_reason(POWER_WAKE_TIMER);
+    timebase_ticks();
+}
+
+// Must run after APP_TIMER_INIT(), before anything reads the timebase
+void timebase_init(void){
+    uint32_t err_code;
+
+    err_code = app_timer_create(&m_refresh_timer_id, APP_TIMER_MODE_REPEATED, refresh_timeout);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_start(m_refresh_timer_id, TIMEBASE_REFRESH_INTERVAL, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+// Read from the main loop and from interrupt handlers alike, so the counter
+// and the wrap count are sampled together
+uint64_t timebase_ticks(void){
+    uint32_t counter;
+    uint64_t ticks;
+
+    CRITICAL_REGION_ENTER();
+    app_timer_cnt_get(&counter);
+    if(counter < m_counter_last){
+        m_wraps++;
+    }
+    m_counter_last = counter;
+    ticks = ((uint64_t)m_wraps << TIMEBASE_COUNTER_BITS) | counter;
+    CRITICAL_REGION_EXIT();
+
+    return ticks;
+}
+
+uint64_t timebase_ms(void){
+    return timebase_ticks_to_ms(timebase_ticks());
+}
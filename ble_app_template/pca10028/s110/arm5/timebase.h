@@ -0,0 +1,27 @@
+/*
+ *  Timebase
+ *
+ *  64-bit monotonic count of RTC1 ticks since timebase_init(). app_timer owns
+ *  RTC1 and its counter is only 24 bits, wrapping every 512 s at prescaler 0,
+ *  so the wraps are counted here. A repeated timer reads the counter four times
+ *  per period, which also keeps app_timer from stopping (and clearing) RTC1 when
+ *  no other timer runs. Conversions to milliseconds are integer only.
+ */
+
+#ifndef TIMEBASE_H__
+#define TIMEBASE_H__
+
+#include <stdint.h>
+
+#define TIMEBASE_PRESCALER 0                    // Must match APP_TIMER_PRESCALER in main.c
+
+void timebase_init(void);
+uint64_t timebase_ticks(void);
+uint64_t timebase_ms(void);
+
+// ms = ticks * 1000 * (PRESCALER + 1) / 32768, with 1000 / 32768 = 125 / 4096
+static inline uint64_t timebase_ticks_to_ms(uint64_t ticks){
+    return (ticks * 125 * (TIMEBASE_PRESCALER + 1)) >> 12;
+}
+
+#endif
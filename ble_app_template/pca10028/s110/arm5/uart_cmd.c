@@ -0,0 +1,268 @@
+#include "uart_cmd.h"
+
+#ifdef UART_COMMANDS
+
+#include <string.h>
+#include "ign_state_machine.h"
+#include "crc16_ccitt.h"
+#include "logger.h"
+#include "app_uart.h"
+#include "app_util_platform.h"
+#include "app_error.h"
+#include "boards.h"
+
+#define SLIP_END     0xC0
+#define SLIP_ESC     0xDB
+#define SLIP_ESC_END 0xDC
+#define SLIP_ESC_ESC 0xDD
+
+#define UART_CMD_RX_BUF_SIZE 64                 // FIFO sizes must be powers of two
+#define UART_CMD_TX_BUF_SIZE 256
+#define UART_CMD_FRAME_MAX (1 + MAX_EVENT_DATA + 2)     // Type, payload and CRC
+#define UART_CMD_RESPONSE_MAX 40                // Responses of one event, like a notification
+
+static uint8_t m_rx_frame[UART_CMD_FRAME_MAX];
+static uint8_t m_rx_len = 0;
+static bool m_rx_escaped = false;
+static bool m_rx_discard = false;               // Frame is bad, skip to the next END
+static uint8_t m_response[UART_CMD_RESPONSE_MAX];
+static uint8_t m_response_len = 0;
+static volatile bool m_session_open = false;
+static bool m_session_closing = false;          // Closed by the controller, CLOSED goes out with the last responses
+static uint32_t m_frames_dropped = 0;
+
+static const EVENT frame_events[] = {
+    [UART_CMD_FRAME_PASSCODE] = EVT_PASSCODE_SET,
+    [UART_CMD_FRAME_OPCODE]   = EVT_OPERATION_SET,
+    [UART_CMD_FRAME_OPERAND]  = EVT_OPERAND_SET,
+    [UART_CMD_FRAME_COMMAND]  = EVT_COMMAND_SET,
+};
+
+static bool slip_put(const uint8_t* p_data, uint8_t len){
+    bool ok = true;
+
+    for(uint8_t i = 0; i < len; i++){
+        if(p_data[i] == SLIP_END){
+            ok &= app_uart_put(SLIP_ESC) == NRF_SUCCESS;
+            ok &= app_uart_put(SLIP_ESC_END) == NRF_SUCCESS;
+        } else if(p_data[i] == SLIP_ESC){
+            ok &= app_uart_put(SLIP_ESC) == NRF_SUCCESS;
+            ok &= app_uart_put(SLIP_ESC_ESC) == NRF_SUCCESS;
+        } else {
+            ok &= app_uart_put(p_data[i]) == NRF_SUCCESS;
+        }
+    }
+    return ok;
+}
+
+// Queues a whole frame at once, so frames from the main loop and the UART
+// interrupt never interleave. A frame that doesn't fit the TX FIFO goes out
+// cut short and the host drops it on its CRC.
+static void frame_send(uint8_t type, const uint8_t* p_data, uint8_t len){
+    uint16_t crc = crc16_update(CRC16_CCITT_INIT, &type, 1);
+    uint8_t crc_bytes[2];
+    bool ok;
+
+    crc = crc16_update(crc, p_data, len);
+    crc_bytes[0] = crc >> 8;
+    crc_bytes[1] = crc;
+
+    CRITICAL_REGION_ENTER();
+    ok = app_uart_put(SLIP_END) == NRF_SUCCESS;
+    ok &= slip_put(&type, 1);
+    ok &= slip_put(p_data, len);
+    ok &= slip_put(crc_bytes, sizeof(crc_bytes));
+    ok &= app_uart_put(SLIP_END) == NRF_SUCCESS;
+    CRITICAL_REGION_EXIT();
+
+    if(!ok){
+        LOG_WARN("UART frame %02X of %d bytes overflowed the TX FIFO", type, len);
+    }
+}
+
+// Runs in the UART interrupt, at the same priority as the other event producers
+static void frame_received(uint8_t type, uint8_t* p_data, uint8_t len){
+    STATE state = current_state_get();
+
+    switch(type){
+        case UART_CMD_FRAME_OPEN:
+            // Same rule as for a phone: one link at a time, and only once the last one is gone
+            if(m_session_open || events_queued() || (state != ST_IDLE && state != ST_UNSEEDED)){
+                LOG_WARN("UART session refused in state %d", state);
+                frame_send(UART_CMD_FRAME_CLOSED, NULL, 0);
+                break;
+            }
+            m_session_open = true;
+            m_session_closing = false;
+            m_response_len = 0;
+            LOG_INFO("UART session opened");
+            add_event(EVT_CONNECTED, NULL, 0);
+            frame_send(UART_CMD_FRAME_OPENED, NULL, 0);
+            break;
+
+        case UART_CMD_FRAME_CLOSE:
+            if(m_session_open && !m_session_closing){
+                m_session_open = false;
+                LOG_INFO("UART session closed by the host");
+                add_event(EVT_DISCONNECTED, NULL, 0);
+            }
+            frame_send(UART_CMD_FRAME_CLOSED, NULL, 0);
+            break;
+
+        case UART_CMD_FRAME_PASSCODE:
+        case UART_CMD_FRAME_OPCODE:
+        case UART_CMD_FRAME_OPERAND:
+        case UART_CMD_FRAME_COMMAND:
+            if(!m_session_open || m_session_closing){
+                frame_send(UART_CMD_FRAME_CLOSED, NULL, 0);
+                break;
+            }
+            add_event(frame_events[type], p_data, len);
+            break;
+
+        default:
+            LOG_WARN("Unknown UART frame type %02X", type);
+            break;
+    }
+}
+
+static void frame_check(void){
+    uint16_t crc;
+
+    if(m_rx_len < 3){
+        m_frames_dropped++;
+        return;
+    }
+
+    crc = crc16_update(CRC16_CCITT_INIT, m_rx_frame, m_rx_len - 2);
+    if(m_rx_frame[m_rx_len - 2] != (uint8_t)(crc >> 8) || m_rx_frame[m_rx_len - 1] != (uint8_t)crc){
+        m_frames_dropped++;
+        LOG_WARN("UART frame with bad CRC dropped (%d dropped)", m_frames_dropped);
+        return;
+    }
+
+    frame_received(m_rx_frame[0], &m_rx_frame[1], m_rx_len - 3);
+}
+
+static void rx_byte(uint8_t byte){
+    if(byte == SLIP_END){
+        // Back to back ENDs delimit nothing
+        if(m_rx_discard){
+            m_frames_dropped++;
+        } else if(m_rx_len){
+            frame_check();
+        }
+        m_rx_len = 0;
+        m_rx_escaped = false;
+        m_rx_discard = false;
+        return;
+    }
+
+    if(m_rx_discard){
+        return;
+    }
+
+    if(m_rx_escaped){
+        m_rx_escaped = false;
+        if(byte == SLIP_ESC_END){
+            byte = SLIP_END;
+        } else if(byte == SLIP_ESC_ESC){
+            byte = SLIP_ESC;
+        } else {
+            m_rx_discard = true;
+            return;
+        }
+    } else if(byte == SLIP_ESC){
+        m_rx_escaped = true;
+        return;
+    }
+
+    if(m_rx_len >= UART_CMD_FRAME_MAX){
+        m_rx_discard = true;
+        return;
+    }
+    m_rx_frame[m_rx_len++] = byte;
+}
+
+static void uart_evt_handler(app_uart_evt_t* p_event){
+    uint8_t byte;
+
+    switch(p_event->evt_type){
+        case APP_UART_DATA_READY:
+            while(app_uart_get(&byte) == NRF_SUCCESS){
+                rx_byte(byte);
+            }
+            break;
+
+        case APP_UART_COMMUNICATION_ERROR:
+        case APP_UART_FIFO_ERROR:
+            // A byte of the frame in progress is lost
+            m_rx_discard = true;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void uart_cmd_init(void){
+    uint32_t err_code;
+    const app_uart_comm_params_t comm_params = {
+        .rx_pin_no    = UART_CMD_RX_PIN,
+        .tx_pin_no    = UART_CMD_TX_PIN,
+        .flow_control = APP_UART_FLOW_CONTROL_DISABLED,
+        .use_parity   = false,
+        .baud_rate    = UART_BAUDRATE_BAUDRATE_Baud115200,
+    };
+
+    APP_UART_FIFO_INIT(&comm_params,
+                       UART_CMD_RX_BUF_SIZE,
+                       UART_CMD_TX_BUF_SIZE,
+                       uart_evt_handler,
+                       APP_IRQ_PRIORITY_LOW,
+                       err_code);
+    APP_ERROR_CHECK(err_code);
+}
+
+bool uart_cmd_session_open(void){
+    return m_session_open;
+}
+
+// Ends the session from the controller side, like dropping a BLE link. The
+// state machine gets EVT_DISCONNECTED and the host CLOSED after the pending
+// responses.
+void uart_cmd_session_close(void){
+    if(!m_session_open || m_session_closing){
+        return;
+    }
+    m_session_closing = true;
+    add_event(EVT_DISCONNECTED, NULL, 0);
+}
+
+void uart_cmd_response_update(const void* data, uint8_t len){
+    if(m_response_len + len > UART_CMD_RESPONSE_MAX){
+        LOG_WARN("UART response overflow, %d bytes dropped", len);
+        return;
+    }
+    memcpy(&m_response[m_response_len], data, len);
+    m_response_len += len;
+}
+
+// Everything responded while handling one event goes out as one frame
+void uart_cmd_tx_flush(void){
+    if(m_response_len){
+        frame_send(UART_CMD_FRAME_RESPONSE, m_response, m_response_len);
+        m_response_len = 0;
+    }
+
+    if(m_session_closing){
+        CRITICAL_REGION_ENTER();
+        m_session_closing = false;
+        m_session_open = false;
+        CRITICAL_REGION_EXIT();
+        LOG_INFO("UART session closed by the controller");
+        frame_send(UART_CMD_FRAME_CLOSED, NULL, 0);
+    }
+}
+
+#endif
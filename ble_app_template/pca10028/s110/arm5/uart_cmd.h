@@ -0,0 +1,59 @@
+/*
+ *  UART Command Channel
+ *
+ *  Wired alternative to the BLE characteristics for bench rigs and the head
+ *  unit. Frames carry the same passcode, opcode, operand and command writes
+ *  and feed the same add_event() path; responses come back framed instead of
+ *  notified. Compiled in only when UART_COMMANDS is defined, since keeping
+ *  the UART receiver on holds the high frequency clock.
+ *
+ *  Frames are SLIP encoded (RFC 1055) and hold a type byte, the payload and
+ *  a big endian CRC-16-CCITT over both. A frame with a bad CRC is dropped.
+ *
+ *  Host to controller                  Controller to host
+ *  0x01 passcode (8 bytes)             0x80 responses, as notified over BLE
+ *  0x02 opcode (1 byte)                0x90 session opened
+ *  0x03 operand (1-4 bytes)            0x91 session closed or refused
+ *  0x04 command frame (14 bytes)
+ *  0x10 open session
+ *  0x11 close session
+ *
+ *  A session stands in for a BLE connection: it is only opened while no
+ *  phone is connected, and phones are turned away while it is open.
+ */
+
+#ifndef UART_CMD_H__
+#define UART_CMD_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UART_CMD_FRAME_PASSCODE 0x01
+#define UART_CMD_FRAME_OPCODE   0x02
+#define UART_CMD_FRAME_OPERAND  0x03
+#define UART_CMD_FRAME_COMMAND  0x04
+#define UART_CMD_FRAME_OPEN     0x10
+#define UART_CMD_FRAME_CLOSE    0x11
+#define UART_CMD_FRAME_RESPONSE 0x80
+#define UART_CMD_FRAME_OPENED   0x90
+#define UART_CMD_FRAME_CLOSED   0x91
+
+#ifdef UART_COMMANDS
+
+void uart_cmd_init(void);
+bool uart_cmd_session_open(void);
+void uart_cmd_session_close(void);
+void uart_cmd_response_update(const void* data, uint8_t len);
+void uart_cmd_tx_flush(void);
+
+#else
+
+#define uart_cmd_init()
+#define uart_cmd_session_open() (false)
+#define uart_cmd_session_close()
+#define uart_cmd_response_update(data, len)
+#define uart_cmd_tx_flush()
+
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+"""
+Decoder for the flight recorder (flight_recorder.h).
+
+The input is the 0x200 bytes at 0x20003E00, either the value of the flight
+recorder characteristic (0x82b3) saved as raw bytes or as hex text, or a
+debugger dump such as J-Link's "savebin fr.bin 0x20003E00 0x200". Records are
+printed oldest first. Times are RTC1 ticks truncated to 24 bits, so they wrap
+every 512 s and only order records within one boot.
+
+Usage: flight_recorder_decode.py <dump.bin | dump.txt>
+"""
+
+import binascii
+import re
+import struct
+import sys
+
+MAGIC = 0x46524543
+HEADER = struct.Struct("<IHBB")
+RECORD = struct.Struct("<IBBBb")
+RAM_SIZE = 0x200
+RECORDS = (RAM_SIZE - HEADER.size) // RECORD.size
+TICKS_PER_SECOND = 32768.0
+
+# Mirrors the enums of ign_state_machine.h and flight_recorder.h
+STATES = ["INVALID", "UNSEEDED", "UNSEEDED_CONNECTED", "IDLE", "CONNECTED",
+          "LOCKED", "UNLOCKED"]
+EVENTS = ["INVALID", "BUTTON_PRESS", "PASSCODE_SET", "CONNECTED",
+          "DISCONNECTED", "TIMED_OUT", "PASSCODE_TIMED_OUT", "OPERATION_SET",
+          "OPERAND_SET", "COMMAND_SET"]
+TYPES = ["BOOT", "QUEUED", "DROPPED", "PROCESSED", "ERROR"]
+RESET_REASONS = ["RESETPIN", "DOG", "SREQ", "LOCKUP", "OFF", "LPCOMP", "DIF"]
+
+
+def name(table, index):
+    return table[index] if index < len(table) else "<%d>" % index
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    text = data.decode("latin-1")
+    if len(data) != RAM_SIZE and re.match(r"^[0-9A-Fa-f\s:\-x]+$", text):
+        # nRF Connect and similar tools show values as "0x43-45-52-46-..."
+        digits = re.sub(r"0x|[\s:\-]", "", text)
+        data = binascii.unhexlify(digits)
+    if len(data) < RAM_SIZE:
+        raise ValueError("%d bytes, expected %d" % (len(data), RAM_SIZE))
+    return data
+
+
+def describe(kind, event, states, response):
+    if kind == 0:
+        reasons = [reason for bit, reason in enumerate(RESET_REASONS) if event & (1 << bit)]
+        return "reset reason %s" % ("|".join(reasons) or "POWER_ON")
+    if kind == 4:
+        return "error code 0x..%02X, line %d" % (event, (states << 8) | (response & 0xFF))
+    old_state, new_state = states >> 4, states & 0x0F
+    text = "%-18s %s" % (name(EVENTS, event), name(STATES, old_state))
+    if kind == 3:
+        if new_state != old_state:
+            text += " -> %s" % name(STATES, new_state)
+        if response:
+            text += ", response %d" % response
+    return text
+
+
+def decode(data):
+    magic, head, boots, wrapped = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or head >= RECORDS:
+        raise ValueError("no flight recorder in this dump")
+    print("%d boots since the recorder was cleared" % boots)
+    order = list(range(head, RECORDS)) + list(range(head)) if wrapped else range(head)
+    for index in order:
+        time, kind, event, states, response = RECORD.unpack_from(data, HEADER.size + index * RECORD.size)
+        print("boot %3d %9.4f s  %-9s %s" % (time >> 24, (time & 0xFFFFFF) / TICKS_PER_SECOND,
+                                             name(TYPES, kind), describe(kind, event, states, response)))
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write(__doc__)
+        return 1
+    try:
+        decode(load(sys.argv[1]))
+    except ValueError as error:
+        sys.stderr.write("%s: %s\n" % (sys.argv[1], error))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
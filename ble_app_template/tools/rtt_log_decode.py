@@ -0,0 +1,122 @@
+#!/usr/bin/env python
+"""
+Decoder for the deferred (LOG_DEFERRED) RTT log stream.
+
+Each record on RTT channel 0 is the address of a format string from the
+log_fmt section, the milliseconds since boot, and one 32-bit little endian
+word per conversion in that format. The format strings, and any strings passed to %s, are read back
+from the .axf the firmware was built from. armlink merges log_fmt into the
+execution region it is placed in (ER_IROM1, so the strings are in flash), so
+a format string is recognised by its "<level>\x1f<file>\x1f<line>\x1f"
+prefix rather than by its section.
+
+Usage: rtt_log_decode.py <firmware.axf> <rtt_capture.bin>
+"""
+
+import re
+import struct
+import sys
+
+LEVELS = {"D": "DEBUG", "I": " INFO", "W": " WARN", "E": "ERROR", "F": "FATAL"}
+CONVERSION = re.compile(r"%(%|[-+ #0]*\d*(?:\.\d+)?[hlL]*[diuxXcsp])")
+
+
+class Image(object):
+    """Loadable sections of a little endian ELF image. The firmware's .axf is
+    ELF32; the host build's LOG_DEFERRED tests are ELF64, linked without PIE
+    so every address still fits the 32-bit words of the stream."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or bytearray(data)[4] not in (1, 2):
+            raise ValueError("%s is not an ELF file" % path)
+        if bytearray(data)[4] == 1:
+            shoff, = struct.unpack_from("<I", data, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+            header_format = "<IIIIII"
+        else:
+            shoff, = struct.unpack_from("<Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", data, 0x3A)
+            header_format = "<IIQQQQ"
+        headers = [struct.unpack_from(header_format, data, shoff + i * shentsize)
+                   for i in range(shnum)]
+        self.regions = []
+        for header in headers:
+            kind, flags, addr, offset, size = header[1:6]
+            if kind == 1 and flags & 0x2:  # SHT_PROGBITS, SHF_ALLOC
+                self.regions.append((addr, data[offset:offset + size]))
+
+    def string(self, address):
+        for base, contents in self.regions:
+            if base <= address < base + len(contents):
+                start = address - base
+                end = contents.find(b"\0", start)
+                return contents[start:end if end >= 0 else len(contents)].decode("latin-1")
+        return "<0x%08X>" % address
+
+    def format(self, address):
+        """Returns the (level, file, line, format) stored at address, or None."""
+        fields = self.string(address).split("\x1f", 3)
+        if len(fields) != 4 or fields[0] not in LEVELS or not fields[2].isdigit():
+            return None
+        return fields
+
+
+def python_conversion(match):
+    """Maps a SEGGER_RTT_printf conversion onto the equivalent Python one."""
+    conversion = match.group(1)
+    if conversion == "%":
+        return "%%"
+    flags = conversion[:-1].replace("l", "").replace("h", "").replace("L", "")
+    return "%" + flags + {"u": "d", "i": "d", "p": "X"}.get(conversion[-1], conversion[-1])
+
+
+def decode(image, stream):
+    formats = {}
+    position = 0
+    while position + 4 <= len(stream):
+        address, = struct.unpack_from("<I", stream, position)
+        position += 4
+        if address not in formats:
+            formats[address] = image.format(address)
+        if formats[address] is None:
+            # Not a record start, resynchronise on the next word
+            continue
+        level, location, line, fmt = formats[address]
+        if position + 4 > len(stream):
+            return
+        millis, = struct.unpack_from("<I", stream, position)
+        position += 4
+        args = []
+        for conversion in CONVERSION.findall(fmt):
+            if conversion == "%":
+                continue
+            if position + 4 > len(stream):
+                return
+            value, = struct.unpack_from("<I", stream, position)
+            position += 4
+            if conversion.endswith("s"):
+                value = image.string(value)
+            elif conversion.endswith("d") or conversion.endswith("i"):
+                value = struct.unpack("<i", struct.pack("<I", value))[0]
+            args.append(value)
+        text = CONVERSION.sub(python_conversion, fmt)
+        prefix = "%8d [%s] " % (millis, LEVELS.get(level, level))
+        if level in "WEF":
+            prefix += "%s(%s): " % (location.replace("\\", "/").split("/")[-1], line)
+        print(prefix + text % tuple(args))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write(__doc__)
+        return 1
+    image = Image(sys.argv[1])
+    with open(sys.argv[2], "rb") as f:
+        decode(image, f.read())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
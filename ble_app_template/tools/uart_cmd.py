@@ -0,0 +1,117 @@
+#!/usr/bin/env python
+"""
+Host side of the UART command channel (uart_cmd.h).
+
+Opens a session on the given serial port (115200 8N1), sends a command frame
+for each opcode/operand pair on the command line with the passcode given in
+hex, prints every frame that comes back and closes the session.
+
+Usage: uart_cmd.py <tty> <passcode hex> <opcode>[:<operand>] ...
+"""
+
+import os
+import struct
+import sys
+import termios
+import time
+
+SLIP_END, SLIP_ESC, SLIP_ESC_END, SLIP_ESC_ESC = 0xC0, 0xDB, 0xDC, 0xDD
+TYPES = {0x80: "RESPONSE", 0x90: "OPENED", 0x91: "CLOSED"}
+FRAME_COMMAND, FRAME_OPEN, FRAME_CLOSE = 0x04, 0x10, 0x11
+TIMEOUT = 1.0
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16-CCITT, as crc16_update() in crc16_ccitt.c."""
+    for byte in bytearray(data):
+        crc = ((crc >> 8) | (crc << 8)) & 0xFFFF
+        crc ^= byte
+        crc ^= (crc & 0xFF) >> 4
+        crc ^= (crc << 12) & 0xFFFF
+        crc ^= ((crc & 0xFF) << 5) & 0xFFFF
+    return crc
+
+
+def encode(kind, payload=b""):
+    body = bytearray([kind]) + bytearray(payload)
+    body += struct.pack(">H", crc16(body))
+    out = bytearray([SLIP_END])
+    for byte in body:
+        if byte == SLIP_END:
+            out += bytearray([SLIP_ESC, SLIP_ESC_END])
+        elif byte == SLIP_ESC:
+            out += bytearray([SLIP_ESC, SLIP_ESC_ESC])
+        else:
+            out.append(byte)
+    out.append(SLIP_END)
+    return bytes(out)
+
+
+class Port(object):
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        attrs = termios.tcgetattr(self.fd)
+        attrs[0] = 0                                        # iflag
+        attrs[1] = 0                                        # oflag
+        attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attrs[3] = 0                                        # lflag
+        attrs[4] = attrs[5] = termios.B115200
+        attrs[6][termios.VMIN] = 0
+        attrs[6][termios.VTIME] = 1
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+        self.frame = bytearray()
+        self.escaped = False
+
+    def send(self, kind, payload=b""):
+        os.write(self.fd, encode(kind, payload))
+
+    def receive(self):
+        """Returns (type, payload) of the next good frame, or None on timeout."""
+        deadline = time.time() + TIMEOUT
+        while time.time() < deadline:
+            for byte in bytearray(os.read(self.fd, 64)):
+                if byte == SLIP_END:
+                    frame, self.frame = self.frame, bytearray()
+                    if len(frame) >= 3 and crc16(frame[:-2]) == struct.unpack(">H", bytes(frame[-2:]))[0]:
+                        return frame[0], bytes(frame[1:-2])
+                elif self.escaped:
+                    self.escaped = False
+                    self.frame.append(SLIP_END if byte == SLIP_ESC_END else SLIP_ESC)
+                elif byte == SLIP_ESC:
+                    self.escaped = True
+                else:
+                    self.frame.append(byte)
+        return None
+
+    def exchange(self, kind, payload=b""):
+        self.send(kind, payload)
+        replies = []
+        reply = self.receive()
+        while reply is not None:
+            kind, data = reply
+            print("%-8s %s" % (TYPES.get(kind, "%02X" % kind), " ".join("%02X" % b for b in bytearray(data))))
+            replies.append(reply)
+            reply = self.receive()
+        return replies
+
+
+def main():
+    if len(sys.argv) < 4:
+        sys.stderr.write(__doc__)
+        return 1
+    port = Port(sys.argv[1])
+    passcode = int(sys.argv[2], 16)
+    if not any(kind == 0x90 for kind, _ in port.exchange(FRAME_OPEN)):
+        sys.stderr.write("session refused\n")
+        return 1
+    for seq, operation in enumerate(sys.argv[3:]):
+        opcode, _, operand = operation.partition(":")
+        frame = struct.pack(">QBIB", passcode, int(opcode, 0), int(operand or "0", 0), seq & 0xFF)
+        port.exchange(FRAME_COMMAND, frame)
+    port.exchange(FRAME_CLOSE)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())